@@ -21,6 +21,10 @@
 #include <boost/limits.hpp>          // for ::std::numeric_limits
 #include <boost/cstdint.hpp>         // for boost::int64_t and BOOST_NO_INTEGRAL_INT64_T
 #include <boost/static_assert.hpp>
+#include <boost/integer/detail/bit_int.hpp>
+#ifdef BOOST_INTEGER_HAS_BITINT
+#include <boost/type_traits/conditional.hpp>
+#endif
 
 //
 // We simply cannot include this header on gcc without getting copious warnings of the kind:
@@ -105,6 +109,12 @@ namespace boost
   template <> struct exact_unsigned_base_helper<sizeof(boost::ulong_long_type)* CHAR_BIT> { typedef boost::ulong_long_type exact; };
 #endif
 
+#ifdef BOOST_INTEGER_HAS_BITINT
+  //  requests for more bits than the widest standard type are met by _BitInt(Bits)
+  template< int Bits > struct int_bit_int_helper { typedef _BitInt(Bits) least; };
+  template< int Bits > struct uint_bit_int_helper { typedef unsigned _BitInt(Bits) least; };
+#endif
+
 
   } // namespace detail
 
@@ -114,6 +124,20 @@ namespace boost
   template< int Bits >   // bits (including sign) required
   struct int_t : public boost::detail::exact_signed_base_helper<Bits>
   {
+#ifdef BOOST_INTEGER_HAS_BITINT
+      BOOST_STATIC_ASSERT_MSG(Bits <= (int)(sizeof(boost::intmax_t) * CHAR_BIT) || Bits <= BOOST_INTEGER_BITINT_MAXWIDTH,
+         "No suitable signed integer type with the requested number of bits is available.");
+      typedef typename boost::conditional<(Bits > (int)(sizeof(boost::intmax_t) * CHAR_BIT)),
+         boost::detail::int_bit_int_helper<Bits>,
+         boost::detail::int_least_helper
+        <
+          1 +
+          (Bits-1 <= ::std::numeric_limits<long>::digits) +
+          (Bits-1 <= ::std::numeric_limits<int>::digits) +
+          (Bits-1 <= ::std::numeric_limits<short>::digits) +
+          (Bits-1 <= ::std::numeric_limits<signed char>::digits)
+        > >::type::least  least;
+#else
       BOOST_STATIC_ASSERT_MSG(Bits <= (int)(sizeof(boost::intmax_t) * CHAR_BIT),
          "No suitable signed integer type with the requested number of bits is available.");
       typedef typename boost::detail::int_least_helper
@@ -128,6 +152,7 @@ namespace boost
           (Bits-1 <= ::std::numeric_limits<short>::digits) +
           (Bits-1 <= ::std::numeric_limits<signed char>::digits)
         >::least  least;
+#endif
       typedef typename int_fast_t<least>::type  fast;
   };
 
@@ -135,6 +160,20 @@ namespace boost
   template< int Bits >   // bits required
   struct uint_t : public boost::detail::exact_unsigned_base_helper<Bits>
   {
+#ifdef BOOST_INTEGER_HAS_BITINT
+     BOOST_STATIC_ASSERT_MSG(Bits <= (int)(sizeof(boost::uintmax_t) * CHAR_BIT) || Bits <= BOOST_INTEGER_BITINT_MAXWIDTH,
+         "No suitable unsigned integer type with the requested number of bits is available.");
+      typedef typename boost::conditional<(Bits > (int)(sizeof(boost::uintmax_t) * CHAR_BIT)),
+         boost::detail::uint_bit_int_helper<Bits>,
+         boost::detail::uint_least_helper
+        <
+          1 +
+          (Bits <= ::std::numeric_limits<unsigned long>::digits) +
+          (Bits <= ::std::numeric_limits<unsigned int>::digits) +
+          (Bits <= ::std::numeric_limits<unsigned short>::digits) +
+          (Bits <= ::std::numeric_limits<unsigned char>::digits)
+        > >::type::least  least;
+#else
      BOOST_STATIC_ASSERT_MSG(Bits <= (int)(sizeof(boost::uintmax_t) * CHAR_BIT),
          "No suitable unsigned integer type with the requested number of bits is available.");
 #if (defined(BOOST_BORLANDC) || defined(__CODEGEAR__)) && defined(BOOST_NO_INTEGRAL_INT64_T)
@@ -159,6 +198,7 @@ namespace boost
           (Bits <= ::std::numeric_limits<unsigned short>::digits) +
           (Bits <= ::std::numeric_limits<unsigned char>::digits)
         >::least  least;
+#endif
 #endif
       typedef typename int_fast_t<least>::type  fast;
       // int_fast_t<> works correctly for unsigned too, in spite of the name.
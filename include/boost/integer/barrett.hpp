@@ -0,0 +1,414 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_BARRETT_HPP
+#define BOOST_INTEGER_BARRETT_HPP
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+//
+// Reduction modulo any p > 0 of at most 32 bits, or 64 where there is a 128-bit type, by the
+// division by an invariant integer of Moller and Granlund: with d = p*2^s normalized so that its top
+// bit is set, and v = floor((2^(2N) - 1)/d) - 2^N for the word width N, the quotient of a two word
+// value by d is estimated with one multiplication by v, and is at most one too small.  Reduction
+// modulo p is reduction of x*2^s modulo d, shifted back.  There are no data dependent branches, so
+// loops of reductions can be vectorized.
+//
+template<class U>
+struct barrett_word
+{
+    typedef typename montgomery_wide< U >::type wide_type;
+    BOOST_STATIC_CONSTEXPR int bits = static_cast<int>(sizeof(U) * CHAR_BIT);
+
+    int shift;          // leading zeros of p
+    U divisor;          // p << shift
+    U reciprocal;       // floor((2^(2N) - 1) / divisor) - 2^N
+    U one;              // 1 mod p
+
+    static BOOST_CXX14_CONSTEXPR int leading_zeros(U p) BOOST_NOEXCEPT
+    {
+        int n = 0;
+        while ((p >> (bits - 1)) == 0u)
+        {
+            p = static_cast<U>(p << 1);
+            ++n;
+        }
+        return n;
+    }
+
+    // p > 0:
+    BOOST_CXX14_CONSTEXPR explicit barrett_word(U p) BOOST_NOEXCEPT
+        : shift(leading_zeros(p)),
+          divisor(static_cast<U>(p << shift)),
+          reciprocal(static_cast<U>(~static_cast<wide_type>(0) / divisor)),
+          one(p == 1u ? 0u : 1u)
+    {}
+
+    // (u1*2^N + u0) mod divisor, for u1 < divisor:
+    BOOST_CXX14_CONSTEXPR U reduce_normalized(U u1, U u0) const BOOST_NOEXCEPT
+    {
+        const wide_type q = static_cast<wide_type>(reciprocal) * u1 + ((static_cast<wide_type>(u1) << bits) | u0);
+        const U q1 = static_cast<U>(static_cast<U>(q >> bits) + 1u);
+        U r = static_cast<U>(u0 - static_cast<U>(q1 * divisor));
+        r = r > static_cast<U>(q) ? static_cast<U>(r + divisor) : r;
+        return r >= divisor ? static_cast<U>(r - divisor) : r;
+    }
+
+    // x mod p, for x < p*2^N:
+    BOOST_CXX14_CONSTEXPR U reduce_product(wide_type x) const BOOST_NOEXCEPT
+    {
+        const U high = static_cast<U>(x >> bits);
+        const U low = static_cast<U>(x);
+        // x*2^shift, with no shift by N when shift is zero:
+        const U u1 = static_cast<U>((high << shift) | ((low >> 1) >> (bits - 1 - shift)));
+        const U u0 = static_cast<U>(low << shift);
+        return static_cast<U>(reduce_normalized(u1, u0) >> shift);
+    }
+    BOOST_CXX14_CONSTEXPR U reduce(U a) const BOOST_NOEXCEPT
+    {
+        return reduce_product(a);
+    }
+    // a, b in [0, p):
+    BOOST_CXX14_CONSTEXPR U mul(U a, U b) const BOOST_NOEXCEPT
+    {
+        return reduce_product(static_cast<wide_type>(a) * b);
+    }
+};
+
+//
+// Barrett reduction of values of N limbs, for the other types: with d = p*2^s normalized so that its
+// top limb has its top bit set, a value x < d*2^(N*bits) is divided by d by Barrett's estimate from the
+// top N + 1 limbs of x and the N + 1 limb reciprocal 2^(N*bits) + v, v as above (algorithm 14.42 of
+// the Handbook of Applied Cryptography), which is at most three too small.
+//
+template<class U, std::size_t N>
+struct barrett_limbs
+{
+    typedef typename montgomery_wide< U >::type wide_type;
+    BOOST_STATIC_CONSTEXPR int bits = static_cast<int>(sizeof(U) * CHAR_BIT);
+    typedef limb_array< U, N > value_type;
+
+    int shift;              // leading zeros of p
+    value_type divisor;     // p << shift
+    value_type reciprocal;  // floor((2^(2N*bits) - 1) / divisor) - 2^(N*bits)
+    value_type one;         // 1 mod p
+
+    // out = x*2^s mod 2^(n*bits), for x and out of n limbs; out may be x:
+    static BOOST_CXX14_CONSTEXPR void shift_left(const U* x, int s, U* out, std::size_t n) BOOST_NOEXCEPT
+    {
+        const std::size_t limbs = static_cast<std::size_t>(s / bits);
+        const int s_bits = s % bits;
+        for (std::size_t i = n - 1; i > limbs; --i)
+        {
+            out[i] = static_cast<U>((x[i - limbs] << s_bits) | ((x[i - limbs - 1] >> 1) >> (bits - 1 - s_bits)));
+        }
+        out[limbs] = static_cast<U>(x[0] << s_bits);
+        for (std::size_t i = 0; i < limbs; ++i)
+        {
+            out[i] = 0;
+        }
+    }
+
+    // out = x/2^s, for x and out of n limbs:
+    static BOOST_CXX14_CONSTEXPR void shift_right(const U* x, int s, U* out, std::size_t n) BOOST_NOEXCEPT
+    {
+        const std::size_t limbs = static_cast<std::size_t>(s / bits);
+        const int s_bits = s % bits;
+        for (std::size_t i = 0; i + limbs + 1 < n; ++i)
+        {
+            out[i] = static_cast<U>((x[i + limbs] >> s_bits) | ((x[i + limbs + 1] << 1) << (bits - 1 - s_bits)));
+        }
+        out[n - limbs - 1] = static_cast<U>(x[n - 1] >> s_bits);
+        for (std::size_t i = n - limbs; i < n; ++i)
+        {
+            out[i] = 0;
+        }
+    }
+
+    // x -= y over n limbs, returning the borrow:
+    static BOOST_CXX14_CONSTEXPR U subtract(U* x, const U* y, std::size_t n) BOOST_NOEXCEPT
+    {
+        U borrow = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const wide_type d = static_cast<wide_type>(static_cast<wide_type>(x[i]) - y[i] - borrow);
+            x[i] = static_cast<U>(d);
+            borrow = static_cast<U>(d >> bits) != 0u ? 1u : 0u;
+        }
+        return borrow;
+    }
+
+    static BOOST_CXX14_CONSTEXPR bool less(const U* x, const U* y, std::size_t n) BOOST_NOEXCEPT
+    {
+        for (std::size_t i = n; i-- > 0;)
+        {
+            if (x[i] != y[i])
+            {
+                return x[i] < y[i];
+            }
+        }
+        return false;
+    }
+
+    static BOOST_CXX14_CONSTEXPR int leading_zeros(const value_type& p) BOOST_NOEXCEPT
+    {
+        int n = 0;
+        std::size_t i = N - 1;
+        while (i > 0 && p.limbs[i] == 0u)
+        {
+            n += bits;
+            --i;
+        }
+        return n + barrett_word< U >::leading_zeros(p.limbs[i]);
+    }
+
+    // p > 0:
+    BOOST_CXX14_CONSTEXPR explicit barrett_limbs(const value_type& p) BOOST_NOEXCEPT
+        : shift(leading_zeros(p)),
+          divisor(),
+          reciprocal(),
+          one()
+    {
+        shift_left(p.limbs, shift, divisor.limbs, N);
+        one.limbs[0] = shift == static_cast<int>(N) * bits - 1 ? 0u : 1u;
+        // Long division of 2^(2N*bits) - 1 by divisor, a bit at a time after the first N limbs, which
+        // leave a quotient of 1 and the remainder 2^(N*bits) - 1 - divisor:
+        U r[N] = {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            r[i] = static_cast<U>(~divisor.limbs[i]);
+        }
+        for (int i = static_cast<int>(N) * bits; i-- > 0;)
+        {
+            const U top = static_cast<U>(r[N - 1] >> (bits - 1));
+            shift_left(r, 1, r, N);
+            r[0] = static_cast<U>(r[0] | 1u);
+            if (top != 0u || !less(r, divisor.limbs, N))
+            {
+                subtract(r, divisor.limbs, N);
+                reciprocal.limbs[i / bits] = static_cast<U>(reciprocal.limbs[i / bits] | (static_cast<U>(1u) << (i % bits)));
+            }
+        }
+    }
+
+    // x mod p, for x of 2N limbs less than p*2^(N*bits):
+    BOOST_CXX14_CONSTEXPR value_type reduce_product(const U* x) const BOOST_NOEXCEPT
+    {
+        U xs[2 * N] = {};
+        shift_left(x, shift, xs, 2 * N);
+        // q = floor(floor(xs / 2^((N-1)*bits)) * (2^(N*bits) + v) / 2^((N+1)*bits)):
+        const U* q1 = xs + (N - 1);
+        U q2[2 * N + 2] = {};
+        for (std::size_t i = 0; i < N + 1; ++i)
+        {
+            U carry = 0;
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                const wide_type s = static_cast<wide_type>(q1[i]) * reciprocal.limbs[j] + q2[i + j] + carry;
+                q2[i + j] = static_cast<U>(s);
+                carry = static_cast<U>(s >> bits);
+            }
+            q2[i + N] = carry;
+        }
+        U carry = 0;
+        for (std::size_t i = 0; i < N + 1; ++i)
+        {
+            const wide_type s = static_cast<wide_type>(q2[i + N]) + q1[i] + carry;
+            q2[i + N] = static_cast<U>(s);
+            carry = static_cast<U>(s >> bits);
+        }
+        q2[2 * N + 1] = static_cast<U>(q2[2 * N + 1] + carry);
+        const U* q = q2 + (N + 1);
+        // r = xs - q*d mod 2^((N+1)*bits), then less d at most three times (the reciprocal is one
+        // less than Barrett's when d is a power of two):
+        U qd[N + 1] = {};
+        for (std::size_t i = 0; i < N + 1; ++i)
+        {
+            carry = 0;
+            for (std::size_t j = 0; j < N && i + j < N + 1; ++j)
+            {
+                const wide_type s = static_cast<wide_type>(q[i]) * divisor.limbs[j] + qd[i + j] + carry;
+                qd[i + j] = static_cast<U>(s);
+                carry = static_cast<U>(s >> bits);
+            }
+            if (i + N < N + 1)
+            {
+                qd[i + N] = carry;
+            }
+        }
+        U r[N + 1] = {};
+        for (std::size_t i = 0; i < N + 1; ++i)
+        {
+            r[i] = xs[i];
+        }
+        subtract(r, qd, N + 1);
+        U d[N + 1] = {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            d[i] = divisor.limbs[i];
+        }
+        for (int i = 0; i < 3 && !less(r, d, N + 1); ++i)
+        {
+            subtract(r, d, N + 1);
+        }
+        value_type result = {};
+        shift_right(r, shift, result.limbs, N);
+        return result;
+    }
+    BOOST_CXX14_CONSTEXPR value_type reduce(const value_type& a) const BOOST_NOEXCEPT
+    {
+        U x[2 * N] = {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = a.limbs[i];
+        }
+        return reduce_product(x);
+    }
+    // a, b in [0, p):
+    BOOST_CXX14_CONSTEXPR value_type mul(const value_type& a, const value_type& b) const BOOST_NOEXCEPT
+    {
+        U x[2 * N] = {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            U carry = 0;
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                const wide_type s = static_cast<wide_type>(a.limbs[j]) * b.limbs[i] + x[i + j] + carry;
+                x[i + j] = static_cast<U>(s);
+                carry = static_cast<U>(s >> bits);
+            }
+            x[i + N] = carry;
+        }
+        return reduce_product(x);
+    }
+};
+
+// As montgomery_engine, for Barrett reduction:
+template<class T, bool word = montgomery_method< T >::value>
+struct barrett_engine
+{
+    typedef typename montgomery_method< T >::word_type value_type;
+    typedef barrett_word< value_type > type;
+
+    static BOOST_CXX14_CONSTEXPR value_type load(const T& a)
+    {
+        return static_cast<value_type>(a);
+    }
+    static BOOST_CXX14_CONSTEXPR T store(const value_type& a)
+    {
+        return static_cast<T>(a);
+    }
+};
+
+template<class T>
+struct barrett_engine<T, false>
+{
+    typedef limb_conversion< T > conversion;
+    typedef barrett_limbs< typename conversion::limb_type, conversion::count > type;
+    typedef typename conversion::value_type value_type;
+
+    static BOOST_CXX14_CONSTEXPR value_type load(const T& a)
+    {
+        return conversion::load(a);
+    }
+    static BOOST_CXX14_CONSTEXPR T store(const value_type& x)
+    {
+        return conversion::store(x);
+    }
+};
+
+} // namespace modular_detail
+
+//
+// Arithmetic modulo a fixed modulus m > 0, odd or even, with the division replaced by
+// multiplications by a precomputed reciprocal of m.  T is an unsigned builtin type or a fixed width
+// unsigned multiprecision type.
+//
+template<class T>
+class barrett_context
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<T>::is_integer && std::numeric_limits<T>::is_bounded && !std::numeric_limits<T>::is_signed,
+        "barrett_context supports unsigned fixed width types only.");
+
+    typedef modular_detail::barrett_engine< T > engine;
+    typedef typename engine::type multiplier_type;
+
+    static BOOST_CXX14_CONSTEXPR const T& checked_modulus(const T& m)
+    {
+        if (m == T(0))
+        {
+            BOOST_THROW_EXCEPTION(std::domain_error("barrett_context: modulus must be > 0"));
+        }
+        return m;
+    }
+
+    T modulus_;
+    multiplier_type mult_;
+
+public:
+    // Throws std::domain_error if modulus is zero.
+    BOOST_CXX14_CONSTEXPR explicit barrett_context(const T& modulus)
+        : modulus_(checked_modulus(modulus)),
+          mult_(engine::load(modulus))
+    {}
+
+    BOOST_CXX14_CONSTEXPR const T& modulus() const BOOST_NOEXCEPT
+    {
+        return modulus_;
+    }
+
+    // a mod m, for any a:
+    BOOST_CXX14_CONSTEXPR T reduce(const T& a) const
+    {
+        return engine::store(mult_.reduce(engine::load(a)));
+    }
+
+    // ab mod m, for a and b in [0, m):
+    BOOST_CXX14_CONSTEXPR T mulmod(const T& a, const T& b) const
+    {
+        return engine::store(mult_.mul(engine::load(a), engine::load(b)));
+    }
+
+    // a^e mod m for any a and e >= 0, by a fixed 4-bit window:
+    template<class E>
+    BOOST_CXX14_CONSTEXPR T powmod(const T& a, const E& e) const
+    {
+        return engine::store(modular_detail::window_pow(mult_, mult_.reduce(engine::load(a)), e));
+    }
+
+    // out[i] = a[i] mod m for i < n; out may be a.
+    void reduce(const T* a, T* out, std::size_t n) const
+    {
+        const multiplier_type mult = mult_;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = engine::store(mult.reduce(engine::load(a[i])));
+        }
+    }
+
+    // out[i] = a[i]*b[i] mod m for i < n, each a[i] and b[i] in [0, m); out may be a or b.
+    void mulmod(const T* a, const T* b, T* out, std::size_t n) const
+    {
+        const multiplier_type mult = mult_;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = engine::store(mult.mul(engine::load(a[i]), engine::load(b[i])));
+        }
+    }
+};
+
+}}
+#endif
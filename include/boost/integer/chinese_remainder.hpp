@@ -0,0 +1,399 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_CHINESE_REMAINDER_HPP
+#define BOOST_INTEGER_CHINESE_REMAINDER_HPP
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/integer/common_factor_rt.hpp>
+#include <boost/integer/extended_euclidean.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/integer/shoup.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+//
+// Garner's algorithm, generalized to moduli which need not be coprime: x is built in mixed radix,
+// x = v[0] + r[0]*(v[1] + r[1]*(v[2] + ...)), where r[i] = m[i]/g[i] and g[i] = gcd(P[i], m[i]) for
+// P[i] = r[0]*...*r[i-1], the lcm of the moduli before m[i].  Given x mod m[i] of the digits so far,
+// a[i] - x must be a multiple of g[i] for there to be a solution, and then the next digit is
+// v[i] = ((a[i] - x)/g[i]) * c[i] mod r[i] with c[i] = 1/(P[i]/g[i]) mod r[i].  Pairwise coprime
+// moduli have every g[i] = 1 and r[i] = m[i].
+//
+// All the multiplications are by values fixed by the moduli, so for unsigned builtin types with a
+// type of twice their width, and moduli of at most 2^(N-1), they are Shoup's, which need no division.
+// Otherwise they use mul_mod.
+//
+template<class Z>
+struct crt_fast
+{
+    static const bool value = boost::is_integral<Z>::value && !std::numeric_limits<Z>::is_signed && montgomery_method< Z >::value;
+};
+
+// A multiplier w modulo p, with Shoup's quotient where it is used:
+template<class Z>
+struct crt_constant
+{
+    Z value;
+    Z quotient;
+};
+
+// The number of residue vectors the array form reconstructs together: each step does the same
+// multiplications for every vector, so the loops over a block can be vectorized.
+BOOST_STATIC_CONSTEXPR std::size_t crt_lanes = 64;
+
+// The number of moduli up to which a single reconstruction keeps its digits on the stack:
+BOOST_STATIC_CONSTEXPR std::size_t crt_stack_moduli = 32;
+
+// x mod r for the cofactor x of extended_euclidean with |x| < r, negative values being wrapped
+// modulo 2^digits for unsigned types:
+template<class Z>
+Z cofactor_residue(const Z& x, const Z& r, const boost::true_type&)
+{
+    return x < Z(0) ? Z(x + r) : x;
+}
+
+template<class Z>
+Z cofactor_residue(const Z& x, const Z& r, const boost::false_type&)
+{
+    return x < r ? x : Z(x + r);
+}
+
+template<class Z>
+class garner_table
+{
+    std::vector<Z> moduli_;
+    std::vector<Z> radices_;                    // r[i]
+    std::vector<Z> divisors_;                   // g[i]
+    std::vector<crt_constant<Z> > inverses_;    // c[i] modulo r[i]
+    std::vector<crt_constant<Z> > ones_;        // 1 modulo m[i], which reduces residues by Shoup's method
+    std::vector<crt_constant<Z> > weights_;     // P[k] modulo m[i] for k < i, at i*(i-1)/2 + k
+    bool coprime_;
+    bool shoup_;
+
+    crt_constant<Z> make_constant(const Z& w, const Z& p) const
+    {
+        crt_constant<Z> c = { w, Z(0) };
+        make_quotient(c, p, boost::integral_constant<bool, crt_fast< Z >::value>());
+        return c;
+    }
+    void make_quotient(crt_constant<Z>& c, const Z& p, const boost::true_type&) const
+    {
+        if (shoup_)
+        {
+            c.quotient = shoup_quotient(c.value, p);
+        }
+    }
+    void make_quotient(crt_constant<Z>&, const Z&, const boost::false_type&) const {}
+
+    // a*c mod p, for a of any value or in [0, p):
+    static Z multiply(const Z& a, const crt_constant<Z>& c, const Z& p, const boost::true_type&)
+    {
+        return shoup_mul(a, c.value, c.quotient, p);
+    }
+    static Z multiply(const Z& a, const crt_constant<Z>& c, const Z& p, const boost::false_type&)
+    {
+        return mul_mod(reduce_residue(a, p), c.value, p);
+    }
+
+public:
+    template<class InputIt>
+    garner_table(InputIt first, InputIt last)
+        : moduli_(first, last), radices_(), divisors_(), inverses_(), ones_(), weights_(), coprime_(true), shoup_(crt_fast< Z >::value)
+    {
+        const std::size_t n = moduli_.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (moduli_[i] < Z(1))
+            {
+                BOOST_THROW_EXCEPTION(std::domain_error("crt_basis: moduli must be > 0"));
+            }
+            if (std::numeric_limits<Z>::is_bounded && moduli_[i] > Z((std::numeric_limits<Z>::max)() / 2 + 1))
+            {
+                shoup_ = false;
+            }
+        }
+        radices_.resize(n);
+        divisors_.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Z& m = moduli_[i];
+            // P[k] mod m for k <= i:
+            Z p = Z(1) % m;
+            for (std::size_t k = 0; k < i; ++k)
+            {
+                weights_.push_back(make_constant(p, m));
+                p = mul_mod(p, reduce_residue(radices_[k], m), m);
+            }
+            const Z g = boost::integer::gcd(p, m);
+            coprime_ = coprime_ && g == Z(1);
+            divisors_[i] = g;
+            radices_[i] = Z(m / g);
+            Z c = Z(0);
+            if (radices_[i] == Z(1))
+            {
+                // m divides P[i], so x mod m is already fixed and only the residue need be checked.
+            }
+            else if (g == Z(1))
+            {
+                c = boost::integer::mod_inverse(p, m);
+            }
+            else
+            {
+                // (P[i]/g) x = 1 mod r[i] for the cofactor x of P[i] in P[i] x + m y = g:
+                c = cofactor_residue(boost::integer::extended_euclidean(p, m).x, radices_[i],
+                    boost::integral_constant<bool, std::numeric_limits<Z>::is_signed>());
+            }
+            inverses_.push_back(make_constant(c, radices_[i]));
+            ones_.push_back(make_constant(Z(Z(1) % m), m));
+        }
+    }
+
+    std::size_t size() const BOOST_NOEXCEPT
+    {
+        return moduli_.size();
+    }
+    const Z& modulus(std::size_t i) const BOOST_NOEXCEPT
+    {
+        return moduli_[i];
+    }
+    const Z& radix(std::size_t i) const BOOST_NOEXCEPT
+    {
+        return radices_[i];
+    }
+    bool coprime() const BOOST_NOEXCEPT
+    {
+        return coprime_;
+    }
+
+    //
+    // The mixed radix digits of Lanes residue vectors at once: on entry digits[i*Lanes + l] is the
+    // residue of vector l modulo m[i], and on exit its digit v[i], or anything for the vectors with no
+    // solution, for which failed[l] is set.  partial holds size()*Lanes values of scratch.
+    //
+    template<std::size_t Lanes>
+    void digits(Z* digits, Z* partial, bool* failed) const
+    {
+        if (shoup_)
+        {
+            digits_imp< Lanes >(digits, partial, failed, boost::integral_constant<bool, crt_fast< Z >::value>());
+        }
+        else
+        {
+            digits_imp< Lanes >(digits, partial, failed, boost::false_type());
+        }
+    }
+
+private:
+    template<std::size_t Lanes, class Fast>
+    void digits_imp(Z* digits, Z* partial, bool* failed, const Fast& fast) const
+    {
+        const std::size_t n = moduli_.size();
+        for (std::size_t i = 0; i < n * Lanes; ++i)
+        {
+            partial[i] = Z(0);
+        }
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+            failed[l] = false;
+        }
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const Z m = moduli_[k];
+            const Z r = radices_[k];
+            const Z g = divisors_[k];
+            const crt_constant<Z> one = ones_[k];
+            const crt_constant<Z> inverse = inverses_[k];
+            Z* v = digits + k * Lanes;
+            const Z* x = partial + k * Lanes;
+            for (std::size_t l = 0; l < Lanes; ++l)
+            {
+                v[l] = sub_mod(multiply(v[l], one, m, fast), x[l], m);
+            }
+            if (g != Z(1))
+            {
+                for (std::size_t l = 0; l < Lanes; ++l)
+                {
+                    failed[l] = failed[l] || v[l] % g != Z(0);
+                    v[l] = Z(v[l] / g);
+                }
+            }
+            if (inverse.value != Z(1))
+            {
+                for (std::size_t l = 0; l < Lanes; ++l)
+                {
+                    v[l] = multiply(v[l], inverse, r, fast);
+                }
+            }
+            // x mod m[i] of the digits so far, for the moduli still to come:
+            for (std::size_t i = k + 1, w = (k + 1) * k / 2 + k; i < n; w += i, ++i)
+            {
+                const Z mi = moduli_[i];
+                const crt_constant<Z> c = weights_[w];
+                Z* y = partial + i * Lanes;
+                for (std::size_t l = 0; l < Lanes; ++l)
+                {
+                    y[l] = add_mod(y[l], multiply(v[l], c, mi, fast), mi);
+                }
+            }
+        }
+    }
+};
+
+} // namespace modular_detail
+
+//
+// The Chinese remainder theorem for a fixed set of moduli m[0..n): reconstructs x in [0, M), M the
+// lcm of the moduli, from its residues modulo each m[i].  The constructor does all the gcds and
+// inverses; each reconstruction is then Garner's algorithm with multiplications by precomputed
+// constants and Horner's rule in R.  R must hold M; it defaults to Z.
+//
+template<class Z, class R = Z>
+class crt_basis
+{
+    modular_detail::garner_table<Z> table_;
+    R product_;
+
+    R combine(const Z* digits, std::size_t stride) const
+    {
+        const std::size_t n = table_.size();
+        if (n == 0)
+        {
+            return R(0);
+        }
+        R x = R(digits[(n - 1) * stride]);
+        for (std::size_t i = n - 1; i-- > 0;)
+        {
+            x = R(x * R(table_.radix(i)) + R(digits[i * stride]));
+        }
+        return x;
+    }
+
+public:
+    //
+    // Takes the moduli from [first, last).  Throws std::domain_error unless every modulus is > 0,
+    // and std::overflow_error if M does not fit R.
+    //
+    template<class InputIt>
+    crt_basis(InputIt first, InputIt last) : table_(first, last), product_(1)
+    {
+        for (std::size_t i = 0; i < table_.size(); ++i)
+        {
+            const R r = R(table_.radix(i));
+            if (std::numeric_limits<R>::is_bounded && product_ > R((std::numeric_limits<R>::max)() / r))
+            {
+                BOOST_THROW_EXCEPTION(std::overflow_error("crt_basis: the lcm of the moduli overflows the result type"));
+            }
+            product_ = R(product_ * r);
+        }
+    }
+
+    std::size_t size() const BOOST_NOEXCEPT
+    {
+        return table_.size();
+    }
+    const Z& modulus(std::size_t i) const BOOST_NOEXCEPT
+    {
+        return table_.modulus(i);
+    }
+    // The lcm of the moduli, their product if they are pairwise coprime:
+    const R& product() const BOOST_NOEXCEPT
+    {
+        return product_;
+    }
+    // Whether the moduli are pairwise coprime, so that every set of residues has a solution:
+    bool coprime() const BOOST_NOEXCEPT
+    {
+        return table_.coprime();
+    }
+
+    //
+    // The x in [0, M) with x = residues[i] mod m[i] for each i < size(); residues may be any values.
+    // The non-throwing form returns false, with result zero, if there is none, which can only happen
+    // when the moduli are not coprime; the other throws std::domain_error.
+    //
+    bool reconstruct(const Z* residues, R& result) const
+    {
+        const std::size_t n = table_.size();
+        Z stack_digits[modular_detail::crt_stack_moduli];
+        Z stack_partial[modular_detail::crt_stack_moduli];
+        std::vector<Z> heap;
+        Z* digits = stack_digits;
+        Z* partial = stack_partial;
+        if (n > modular_detail::crt_stack_moduli)
+        {
+            heap.resize(2 * n);
+            digits = heap.data();
+            partial = digits + n;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            digits[i] = residues[i];
+        }
+        bool failed = false;
+        table_.template digits<1>(digits, partial, &failed);
+        result = failed ? R(0) : combine(digits, 1);
+        return !failed;
+    }
+
+    R reconstruct(const Z* residues) const
+    {
+        R result = R(0);
+        if (!reconstruct(residues, result))
+        {
+            BOOST_THROW_EXCEPTION(std::domain_error("crt_basis: the residues are inconsistent"));
+        }
+        return result;
+    }
+
+    //
+    // Reconstructs count values, the j-th from residues[j*size() .. (j+1)*size()), into out[j], and
+    // returns the number with no solution, which are set to zero.
+    //
+    std::size_t reconstruct(const Z* residues, R* out, std::size_t count) const
+    {
+        const std::size_t n = table_.size();
+        const std::size_t lanes = modular_detail::crt_lanes;
+        std::vector<Z> scratch(2 * n * lanes);
+        Z* digits = scratch.data();
+        Z* partial = digits + n * lanes;
+        bool failed[modular_detail::crt_lanes];
+        std::size_t failures = 0;
+        for (std::size_t start = 0; start < count; start += lanes)
+        {
+            const std::size_t block = count - start < lanes ? count - start : lanes;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (std::size_t l = 0; l < block; ++l)
+                {
+                    digits[i * lanes + l] = residues[(start + l) * n + i];
+                }
+                for (std::size_t l = block; l < lanes; ++l)
+                {
+                    digits[i * lanes + l] = Z(0);
+                }
+            }
+            table_.template digits<modular_detail::crt_lanes>(digits, partial, failed);
+            for (std::size_t l = 0; l < block; ++l)
+            {
+                failures += failed[l];
+                out[start + l] = failed[l] ? R(0) : combine(digits + l, lanes);
+            }
+        }
+        return failures;
+    }
+};
+
+}}
+#endif
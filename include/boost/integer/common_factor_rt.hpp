@@ -9,6 +9,9 @@
 
 #include <boost/assert.hpp>
 #include <boost/core/enable_if.hpp>
+#include <boost/integer/detail/gcd_tuning.hpp>
+#include <boost/integer/detail/bit_int.hpp>
+#include <boost/integer_fwd.hpp>  // for the default arguments of gcd_evaluator and lcm_evaluator
 
 #include <boost/config.hpp>  // for BOOST_NESTED_TEMPLATE, etc.
 #include <boost/limits.hpp>  // for std::numeric_limits
@@ -79,6 +82,68 @@ namespace boost {
          }
 #endif
 
+         //
+         // Position of the most significant bit of val > 0, for method_adaptive.  Unlike integer_log2 this
+         // is usable in constant expressions: a power of two is found above the width of val, without
+         // shifting by the whole width of a bounded type, and the bits below it are then found by halving.
+         //
+         template <class T>
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(T val) BOOST_GCD_NOEXCEPT(T)
+         {
+            const int limit = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ? std::numeric_limits<T>::digits : INT_MAX;
+            int step = 1;
+            while (step < limit / 2 && T(val >> (2 * step)) != T(0))
+               step *= 2;
+            int result = 0;
+            for (; step > 0; step /= 2)
+            {
+               while (T(val >> step) != T(0))
+               {
+                  val = T(val >> step);
+                  result += step;
+               }
+            }
+            return result;
+         }
+#if defined(BOOST_GCC) || defined(__clang__) || (defined(BOOST_INTEL) && defined(__GNUC__))
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(unsigned val) BOOST_NOEXCEPT
+         {
+            return std::numeric_limits<unsigned>::digits - 1 - __builtin_clz(val);
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(unsigned long val) BOOST_NOEXCEPT
+         {
+            return std::numeric_limits<unsigned long>::digits - 1 - __builtin_clzl(val);
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(boost::ulong_long_type val) BOOST_NOEXCEPT
+         {
+            return std::numeric_limits<boost::ulong_long_type>::digits - 1 - __builtin_clzll(val);
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(int val) BOOST_NOEXCEPT
+         {
+            return constexpr_log2(static_cast<unsigned>(val));
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(long val) BOOST_NOEXCEPT
+         {
+            return constexpr_log2(static_cast<unsigned long>(val));
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(boost::long_long_type val) BOOST_NOEXCEPT
+         {
+            return constexpr_log2(static_cast<boost::ulong_long_type>(val));
+         }
+#endif
+#ifdef BOOST_HAS_INT128
+         // std::numeric_limits is not specialized for these in strict modes:
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(boost::uint128_type val) BOOST_NOEXCEPT
+         {
+            const boost::ulong_long_type high = static_cast<boost::ulong_long_type>(val >> 64);
+            return high != 0u ? 64 + constexpr_log2(high) : constexpr_log2(static_cast<boost::ulong_long_type>(val));
+         }
+         inline BOOST_CXX14_CONSTEXPR int constexpr_log2(boost::int128_type val) BOOST_NOEXCEPT
+         {
+            return constexpr_log2(static_cast<boost::uint128_type>(val));
+         }
+#endif
+
       template <class T, bool a =
 #ifndef BOOST_NO_CXX11_HDR_TYPE_TRAITS
          std::is_unsigned<T>::value ||
@@ -98,13 +163,6 @@ namespace boost {
          }
       };
 
-      enum method_type
-      {
-         method_euclid = 0,
-         method_binary = 1,
-         method_mixed = 2
-      };
-
       struct any_convert
       {
          template <class T>
@@ -150,7 +208,27 @@ namespace boost {
          static const bool has_operator_left_shift_equal = true;
          static const bool has_operator_right_shift_equal = true;
 #endif
-         static const method_type method = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_integer && has_operator_left_shift_equal && has_operator_right_shift_equal ? method_mixed : method_euclid;
+         static const method_type method = gcd_tuning<T>::is_tuned ? gcd_tuning<T>::method :
+            std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_integer && has_operator_left_shift_equal && has_operator_right_shift_equal ? method_mixed : method_euclid;
+         //
+         // Crossover points used by method_adaptive, all in bits: Euclid is used when the larger
+         // operand is at least adaptive_euclid_min_bits wide, or the operand widths differ by at least
+         // adaptive_euclid_min_bit_difference, otherwise Stein when both operands are no wider than
+         // adaptive_binary_max_bits, otherwise mixed binary.  The untuned defaults (see gcd_tuning)
+         // reflect the observation that mixed binary wins throughout the range of the builtin types,
+         // but that once operands span several limbs the division in Euclid's algorithm is cheaper
+         // than the many shifts and subtractions the binary methods need.
+         //
+         static const int adaptive_binary_max_bits = gcd_tuning<T>::adaptive_binary_max_bits;
+         static const int adaptive_euclid_min_bits = gcd_tuning<T>::adaptive_euclid_min_bits;
+         static const int adaptive_euclid_min_bit_difference = gcd_tuning<T>::adaptive_euclid_min_bit_difference;
+         //
+         // Position of the most significant bit of val > 0:
+         //
+         inline static BOOST_CXX14_CONSTEXPR int log2(const T& val) BOOST_GCD_NOEXCEPT(T)
+         {
+            return constexpr_log2(val);
+         }
       };
       //
       // Default gcd_traits just inherits from defaults:
@@ -319,6 +397,75 @@ namespace boost {
       };
 #endif
 #endif
+
+#ifdef BOOST_INTEGER_HAS_BITINT
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wbit-int-extension"
+      //
+      // _BitInt(N): std::numeric_limits is not specialized, which would otherwise select Euclid's
+      // algorithm.  Up to 128 bits %= is a single library call and mixed binary is best, beyond that
+      // division is a generic multi-limb routine and the binary algorithm, which needs only shifts and
+      // subtractions, is used instead.  make_odd skips whole zero 64-bit limbs before scanning.
+      //
+      template <int N>
+      struct gcd_traits<unsigned _BitInt(N)> : public gcd_traits_defaults<unsigned _BitInt(N)>
+      {
+         static const method_type method = gcd_tuning<unsigned _BitInt(N)>::is_tuned ? gcd_tuning<unsigned _BitInt(N)>::method :
+            N <= 128 ? method_mixed : method_binary;
+
+         BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR unsigned find_lsb(unsigned _BitInt(N) mask)BOOST_NOEXCEPT
+         {
+            unsigned shift = 0;
+            while (static_cast<boost::ulong_long_type>(mask >> shift) == 0u)
+               shift += 64;
+            return shift + __builtin_ctzll(static_cast<boost::ulong_long_type>(mask >> shift));
+         }
+         BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR unsigned make_odd(unsigned _BitInt(N)& val)BOOST_NOEXCEPT
+         {
+            unsigned result = find_lsb(val);
+            val >>= result;
+            return result;
+         }
+         inline static BOOST_CXX14_CONSTEXPR int log2(unsigned _BitInt(N) val)BOOST_NOEXCEPT
+         {
+            int shift = ((N - 1) / 64) * 64;
+            while (shift > 0 && static_cast<boost::ulong_long_type>(val >> shift) == 0u)
+               shift -= 64;
+            return shift + 63 - __builtin_clzll(static_cast<boost::ulong_long_type>(val >> shift));
+         }
+      };
+      template <int N>
+      struct gcd_traits<_BitInt(N)> : public gcd_traits_defaults<_BitInt(N)>
+      {
+         static const method_type method = gcd_tuning<_BitInt(N)>::is_tuned ? gcd_tuning<_BitInt(N)>::method :
+            N <= 128 ? method_mixed : method_binary;
+
+         BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR unsigned make_odd(_BitInt(N)& val)BOOST_NOEXCEPT { unsigned result = gcd_traits<unsigned _BitInt(N)>::find_lsb(val); val >>= result; return result; }
+         inline static BOOST_CXX14_CONSTEXPR int log2(_BitInt(N) val)BOOST_NOEXCEPT { return gcd_traits<unsigned _BitInt(N)>::log2(val); }
+      };
+#pragma clang diagnostic pop
+#endif
+   //
+   // Instrumentation hooks called from within the algorithms below: begin() at the start of each call,
+   // then iteration() once per trip around the main loop, modulo() for each %= and shift(n) for each
+   // n bits removed by make_odd.  The default policy does nothing and compiles away; defining
+   // BOOST_INTEGER_GCD_INSTRUMENTATION to the name of a class with the same static members (which must
+   // be declared before this header is included, see <boost/integer/gcd_instrumentation.hpp>) replaces it.
+   //
+   struct null_gcd_instrumentation
+   {
+      BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR void begin(method_type) BOOST_NOEXCEPT {}
+      BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR void iteration() BOOST_NOEXCEPT {}
+      BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR void modulo() BOOST_NOEXCEPT {}
+      BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR void shift(unsigned) BOOST_NOEXCEPT {}
+   };
+
+#ifdef BOOST_INTEGER_GCD_INSTRUMENTATION
+   typedef BOOST_INTEGER_GCD_INSTRUMENTATION gcd_instrumentation;
+#else
+   typedef null_gcd_instrumentation gcd_instrumentation;
+#endif
+
    //
    // The Mixed Binary Euclid Algorithm
    // Sidi Mohamed Sedjelmaci
@@ -327,6 +474,7 @@ namespace boost {
    template <class T>
    BOOST_CXX14_CONSTEXPR T mixed_binary_gcd(T u, T v) BOOST_GCD_NOEXCEPT(T)
    {
+      gcd_instrumentation::begin(method_mixed);
       if(gcd_traits<T>::less(u, v))
          constexpr_swap(u, v);
 
@@ -337,18 +485,23 @@ namespace boost {
       if(v == T(0))
          return u;
 
-      shifts = constexpr_min(gcd_traits<T>::make_odd(u), gcd_traits<T>::make_odd(v));
+      unsigned shifts_u = gcd_traits<T>::make_odd(u);
+      unsigned shifts_v = gcd_traits<T>::make_odd(v);
+      gcd_instrumentation::shift(shifts_u + shifts_v);
+      shifts = constexpr_min(shifts_u, shifts_v);
 
       while(gcd_traits<T>::less(1, v))
       {
+         gcd_instrumentation::iteration();
+         gcd_instrumentation::modulo();
          u %= v;
          v -= u;
          if(u == T(0))
             return v << shifts;
          if(v == T(0))
             return u << shifts;
-         gcd_traits<T>::make_odd(u);
-         gcd_traits<T>::make_odd(v);
+         gcd_instrumentation::shift(gcd_traits<T>::make_odd(u));
+         gcd_instrumentation::shift(gcd_traits<T>::make_odd(v));
          if(gcd_traits<T>::less(u, v))
             constexpr_swap(u, v);
       }
@@ -364,6 +517,7 @@ namespace boost {
     {
         BOOST_ASSERT(m >= 0);
         BOOST_ASSERT(n >= 0);
+        gcd_instrumentation::begin(method_binary);
         if (m == SteinDomain(0))
             return n;
         if (n == SteinDomain(0))
@@ -371,13 +525,15 @@ namespace boost {
         // m > 0 && n > 0
         unsigned d_m = gcd_traits<SteinDomain>::make_odd(m);
         unsigned d_n = gcd_traits<SteinDomain>::make_odd(n);
+        gcd_instrumentation::shift(d_m + d_n);
         // odd(m) && odd(n)
         while (m != n)
         {
+            gcd_instrumentation::iteration();
             if (n > m)
                constexpr_swap(n, m);
             m -= n;
-            gcd_traits<SteinDomain>::make_odd(m);
+            gcd_instrumentation::shift(gcd_traits<SteinDomain>::make_odd(m));
         }
         // m == n
         m <<= constexpr_min(d_m, d_n);
@@ -393,8 +549,11 @@ namespace boost {
     template <typename EuclideanDomain>
     inline BOOST_CXX14_CONSTEXPR EuclideanDomain Euclid_gcd(EuclideanDomain a, EuclideanDomain b) BOOST_GCD_NOEXCEPT(EuclideanDomain)
     {
+        gcd_instrumentation::begin(method_euclid);
         while (b != EuclideanDomain(0))
         {
+            gcd_instrumentation::iteration();
+            gcd_instrumentation::modulo();
             a %= b;
             constexpr_swap(a, b);
         }
@@ -402,6 +561,37 @@ namespace boost {
     }
 
 
+    /** Run time algorithm selection
+     *
+     * Picks Euclid, Stein or mixed binary for each call from the bit widths of the operands,
+     * using the crossover points in gcd_traits<T>.  Requires the same shift operators as the
+     * binary methods.
+     */
+    template <class T>
+    BOOST_CXX14_CONSTEXPR T adaptive_gcd(T u, T v) BOOST_GCD_NOEXCEPT(T)
+    {
+       if (u == T(0))
+          return v;
+       if (v == T(0))
+          return u;
+       int bits_u = gcd_traits<T>::log2(u) + 1;
+       int bits_v = gcd_traits<T>::log2(v) + 1;
+       int wider = bits_u < bits_v ? bits_v : bits_u;
+       int difference = bits_u < bits_v ? bits_v - bits_u : bits_u - bits_v;
+       if ((wider >= gcd_traits<T>::adaptive_euclid_min_bits) || (difference >= gcd_traits<T>::adaptive_euclid_min_bit_difference))
+          return Euclid_gcd(u, v);
+       if (wider <= gcd_traits<T>::adaptive_binary_max_bits)
+          return Stein_gcd(u, v);
+       return mixed_binary_gcd(u, v);
+    }
+
+    template <typename T>
+    inline BOOST_CXX14_CONSTEXPR BOOST_DEDUCED_TYPENAME enable_if_c<gcd_traits<T>::method == method_adaptive, T>::type
+       optimal_gcd_select(T const &a, T const &b) BOOST_GCD_NOEXCEPT(T)
+    {
+       return gcd_detail::adaptive_gcd(a, b);
+    }
+
     template <typename T>
     inline BOOST_CXX14_CONSTEXPR BOOST_DEDUCED_TYPENAME enable_if_c<gcd_traits<T>::method == method_mixed, T>::type
        optimal_gcd_select(T const &a, T const &b) BOOST_GCD_NOEXCEPT(T)
@@ -542,10 +732,15 @@ public:
    typedef IntegerType second_argument_type;
    typedef IntegerType result_type;
 #endif
-   IntegerType operator()(IntegerType const &a, IntegerType const &b) const
+   BOOST_CXX14_CONSTEXPR IntegerType operator()(IntegerType const &a, IntegerType const &b) const BOOST_GCD_NOEXCEPT(IntegerType)
    {
       return boost::integer::gcd(a, b);
    }
+   // The identity element, for use as the initial value of a reduction:
+   static BOOST_CXX14_CONSTEXPR IntegerType identity() BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return IntegerType(0);
+   }
 };
 
 template < typename IntegerType >
@@ -560,12 +755,85 @@ public:
    typedef IntegerType second_argument_type;
    typedef IntegerType result_type;
 #endif
-   IntegerType operator()(IntegerType const &a, IntegerType const &b)const
+   BOOST_CXX14_CONSTEXPR IntegerType operator()(IntegerType const &a, IntegerType const &b)const BOOST_GCD_NOEXCEPT(IntegerType)
    {
       return boost::integer::lcm(a, b);
    }
+   // The identity element, for use as the initial value of a reduction:
+   static BOOST_CXX14_CONSTEXPR IntegerType identity() BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return IntegerType(1);
+   }
 };
 
+#if !defined(BOOST_NO_CXX11_HDR_TYPE_TRAITS) && !defined(BOOST_NO_CXX11_DECLTYPE)
+namespace gcd_detail {
+   //
+   // An argument of the transparent evaluators converted to the common type R.  A negative
+   // signed argument would wrap on conversion to an unsigned R, as for (-12, 18u), so it is
+   // converted as its magnitude instead, whose gcd and lcm are the same.
+   //
+   template <class R, class T>
+   BOOST_CXX14_CONSTEXPR typename std::enable_if<std::is_unsigned<R>::value && std::is_signed<T>::value, R>::type
+      evaluator_operand(const T& a) BOOST_NOEXCEPT
+   {
+      return a < T(0) ? static_cast<R>(R(0) - static_cast<R>(a)) : static_cast<R>(a);
+   }
+   template <class R, class T>
+   BOOST_CXX14_CONSTEXPR typename std::enable_if<!(std::is_unsigned<R>::value && std::is_signed<T>::value), R>::type
+      evaluator_operand(const T& a) BOOST_NOEXCEPT_IF((std::is_arithmetic<R>::value))
+   {
+      return static_cast<R>(a);
+   }
+}
+
+//
+// Transparent versions, gcd_evaluator<> and lcm_evaluator<>, which deduce the argument types
+// and convert both to their common type; where that is unsigned, a negative argument is
+// converted as its magnitude.  Being stateless, pure and associative/commutative they are
+// suitable as the operation of std::reduce with any execution policy.
+//
+template <>
+class gcd_evaluator<void>
+{
+public:
+   typedef void is_transparent;
+
+   template <class T, class U>
+   BOOST_CXX14_CONSTEXPR typename std::common_type<T, U>::type operator()(T const &a, U const &b) const
+      BOOST_NOEXCEPT_IF((std::is_arithmetic<typename std::common_type<T, U>::type>::value))
+   {
+      typedef typename std::common_type<T, U>::type result_type;
+      return boost::integer::gcd(gcd_detail::evaluator_operand<result_type>(a), gcd_detail::evaluator_operand<result_type>(b));
+   }
+   template <class T>
+   static BOOST_CXX14_CONSTEXPR T identity() BOOST_GCD_NOEXCEPT(T)
+   {
+      return T(0);
+   }
+};
+
+template <>
+class lcm_evaluator<void>
+{
+public:
+   typedef void is_transparent;
+
+   template <class T, class U>
+   BOOST_CXX14_CONSTEXPR typename std::common_type<T, U>::type operator()(T const &a, U const &b) const
+      BOOST_NOEXCEPT_IF((std::is_arithmetic<typename std::common_type<T, U>::type>::value))
+   {
+      typedef typename std::common_type<T, U>::type result_type;
+      return boost::integer::lcm(gcd_detail::evaluator_operand<result_type>(a), gcd_detail::evaluator_operand<result_type>(b));
+   }
+   template <class T>
+   static BOOST_CXX14_CONSTEXPR T identity() BOOST_GCD_NOEXCEPT(T)
+   {
+      return T(1);
+   }
+};
+#endif
+
 }  // namespace integer
 }  // namespace boost
 
@@ -0,0 +1,23 @@
+//  Boost integer/detail/bit_int.hpp header file  ----------------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_DETAIL_BIT_INT_HPP
+#define BOOST_INTEGER_DETAIL_BIT_INT_HPP
+
+//
+// BOOST_INTEGER_HAS_BITINT is defined when the compiler accepts the C23 bit-precise integer
+// types, _BitInt(N), in C++ and supports widths beyond 64 bits, in which case
+// BOOST_INTEGER_BITINT_MAXWIDTH is the largest supported N.  Currently that means clang;
+// define BOOST_INTEGER_NO_BITINT to disable the support.
+//
+#if !defined(BOOST_INTEGER_NO_BITINT) && defined(__clang__) && defined(__BITINT_MAXWIDTH__) && (__BITINT_MAXWIDTH__ > 64)
+#define BOOST_INTEGER_HAS_BITINT
+#define BOOST_INTEGER_BITINT_MAXWIDTH __BITINT_MAXWIDTH__
+#endif
+
+#endif  // BOOST_INTEGER_DETAIL_BIT_INT_HPP
@@ -0,0 +1,49 @@
+//  Boost integer/detail/gcd_tuning.hpp header file  -------------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_DETAIL_GCD_TUNING_HPP
+#define BOOST_INTEGER_DETAIL_GCD_TUNING_HPP
+
+namespace boost {
+namespace integer {
+namespace gcd_detail {
+
+   enum method_type
+   {
+      method_euclid = 0,
+      method_binary = 1,
+      method_mixed = 2,
+      method_adaptive = 3  // choose one of the above per call, from the operands' bit widths
+   };
+
+   //
+   // Per-type overrides of the gcd_traits_defaults algorithm choice and method_adaptive
+   // crossover points.  The primary template carries the untuned defaults; specializations,
+   // normally generated for the build machine by the gcd_autotune tool (see the CMake option
+   // BOOST_INTEGER_GCD_AUTOTUNE), set is_tuned and are picked up when the header containing
+   // them is named by BOOST_INTEGER_GCD_TUNING_HEADER.
+   //
+   template <class T>
+   struct gcd_tuning
+   {
+      static const bool is_tuned = false;
+      static const method_type method = method_mixed;  // unused unless is_tuned
+      static const int adaptive_binary_max_bits = 0;
+      static const int adaptive_euclid_min_bits = 65;
+      static const int adaptive_euclid_min_bit_difference = 64;
+   };
+
+} // namespace gcd_detail
+} // namespace integer
+} // namespace boost
+
+#ifdef BOOST_INTEGER_GCD_TUNING_HEADER
+#include BOOST_INTEGER_GCD_TUNING_HEADER
+#endif
+
+#endif  // BOOST_INTEGER_DETAIL_GCD_TUNING_HPP
@@ -0,0 +1,298 @@
+//  Boost integer/detail/modular_multiply.hpp header file  --------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_DETAIL_MODULAR_MULTIPLY_HPP
+#define BOOST_INTEGER_DETAIL_MODULAR_MULTIPLY_HPP
+
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/integer/mod_inverse.hpp>
+
+namespace boost {
+namespace integer {
+namespace modular_detail {
+
+   //
+   // a*b mod m, for a and b in [0, m), and the modular addition it may be built from.
+   //
+   // Builtin types multiply in a type of twice the width where there is one; otherwise, and for
+   // fixed width multiprecision types whose product may overflow, by doubling and adding.
+   // Unbounded types simply multiply and reduce.
+   //
+   template <class Z>
+   struct mul_mod_method
+   {
+      static const int bits = boost::is_integral<Z>::value ? static_cast<int>(sizeof(Z) * CHAR_BIT) : 0;
+      static const bool by_uint64 = boost::is_integral<Z>::value && bits <= 32;
+#ifdef BOOST_HAS_INT128
+      static const bool by_uint128 = boost::is_integral<Z>::value && bits > 32 && bits <= 64;
+#else
+      static const bool by_uint128 = false;
+#endif
+      static const bool by_product = !boost::is_integral<Z>::value && !std::numeric_limits<Z>::is_bounded;
+      static const bool by_doubling = !by_uint64 && !by_uint128 && !by_product;
+   };
+
+   // a mod m in [0, m), for m > 0:
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline Z reduce_residue(const Z& a, const Z& m, const boost::true_type&)
+   {
+      Z r = Z(a % m);
+      return r < Z(0) ? Z(r + m) : r;
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline Z reduce_residue(const Z& a, const Z& m, const boost::false_type&)
+   {
+      return Z(a % m);
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline Z reduce_residue(const Z& a, const Z& m)
+   {
+      return reduce_residue(a, m, boost::integral_constant<bool, std::numeric_limits<Z>::is_signed>());
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline Z add_mod(const Z& a, const Z& b, const Z& m)
+   {
+      // a + b may overflow Z, m - b may not:
+      return a >= m - b ? Z(a - (m - b)) : Z(a + b);
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline Z sub_mod(const Z& a, const Z& b, const Z& m)
+   {
+      return a >= b ? Z(a - b) : Z(a + (m - b));
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline typename boost::enable_if_c<mul_mod_method<Z>::by_uint64, Z>::type
+      mul_mod(const Z& a, const Z& b, const Z& m) BOOST_NOEXCEPT
+   {
+      return static_cast<Z>(static_cast<boost::uint64_t>(a) * static_cast<boost::uint64_t>(b) % static_cast<boost::uint64_t>(m));
+   }
+
+#ifdef BOOST_HAS_INT128
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline typename boost::enable_if_c<mul_mod_method<Z>::by_uint128, Z>::type
+      mul_mod(const Z& a, const Z& b, const Z& m) BOOST_NOEXCEPT
+   {
+      return static_cast<Z>(static_cast<boost::uint128_type>(a) * static_cast<boost::uint128_type>(b) % static_cast<boost::uint128_type>(m));
+   }
+#endif
+
+   template <class Z>
+   inline typename boost::enable_if_c<mul_mod_method<Z>::by_product, Z>::type
+      mul_mod(const Z& a, const Z& b, const Z& m)
+   {
+      return Z(a * b % m);
+   }
+
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR inline typename boost::enable_if_c<mul_mod_method<Z>::by_doubling, Z>::type
+      mul_mod(const Z& a, Z b, const Z& m)
+   {
+      Z result = 0;
+      Z addend = a;
+      while (b != Z(0))
+      {
+         if ((b & 1u) != 0u)
+            result = add_mod(result, addend, m);
+         addend = add_mod(addend, addend, m);
+         b >>= 1;
+      }
+      return result;
+   }
+
+   //
+   // Montgomery multiplication modulo an odd p of at most 32 bits, or 64 where there is a 128-bit
+   // type: values are held as aR mod p, R = 2^N for the word width N, and a product is reduced by
+   // subtracting the high half of m*p, m chosen to clear the low half of the product, from its
+   // high half.  That difference lies in (-p, p), so nothing overflows even for p close to 2^N.
+   //
+   template <class Z>
+   struct montgomery_method
+   {
+      static const bool value = mul_mod_method<Z>::by_uint64 || mul_mod_method<Z>::by_uint128;
+#ifdef BOOST_HAS_INT128
+      typedef typename boost::conditional<mul_mod_method<Z>::by_uint128, boost::uint64_t, boost::uint32_t>::type word_type;
+#else
+      typedef boost::uint32_t word_type;
+#endif
+   };
+
+   template <class U>
+   struct montgomery_wide;
+
+   template <>
+   struct montgomery_wide<boost::uint32_t>
+   {
+      typedef boost::uint64_t type;
+   };
+
+#ifdef BOOST_HAS_INT128
+   template <>
+   struct montgomery_wide<boost::uint64_t>
+   {
+      typedef boost::uint128_type type;
+   };
+#endif
+
+   template <class U>
+   struct montgomery_word
+   {
+      typedef typename montgomery_wide<U>::type wide_type;
+      BOOST_STATIC_CONSTEXPR int bits = static_cast<int>(sizeof(U) * CHAR_BIT);
+
+      U modulus;
+      U modulus_inverse;  // 1/p mod R
+      U one;              // R mod p
+      U r_squared;        // R^2 mod p
+
+      BOOST_CXX14_CONSTEXPR explicit montgomery_word(U p) BOOST_NOEXCEPT
+         : modulus(p),
+           modulus_inverse(boost::integer::inverse_mod_pow2(p)),
+           one(static_cast<U>(static_cast<U>(U(0) - p) % p)),
+           r_squared(static_cast<U>(static_cast<wide_type>(one) * one % p))
+      {}
+
+      BOOST_CXX14_CONSTEXPR U reduce(wide_type t) const BOOST_NOEXCEPT
+      {
+         U m = static_cast<U>(static_cast<U>(t) * modulus_inverse);
+         U high = static_cast<U>(t >> bits);
+         U mp_high = static_cast<U>((static_cast<wide_type>(m) * modulus) >> bits);
+         U result = static_cast<U>(high - mp_high);
+         return high < mp_high ? static_cast<U>(result + modulus) : result;
+      }
+      BOOST_CXX14_CONSTEXPR U mul(U a, U b) const BOOST_NOEXCEPT
+      {
+         return reduce(static_cast<wide_type>(a) * b);
+      }
+      // a in [0, p) to and from Montgomery form:
+      BOOST_CXX14_CONSTEXPR U to_montgomery(U a) const BOOST_NOEXCEPT
+      {
+         return mul(a, r_squared);
+      }
+      BOOST_CXX14_CONSTEXPR U from_montgomery(U a) const BOOST_NOEXCEPT
+      {
+         return reduce(a);
+      }
+   };
+
+   //
+   // Values of the types montgomery_word can't take, as arrays of the widest word which has a type of
+   // twice its width, least significant first, converted with T's own masks and shifts.
+   //
+   template <class U, std::size_t N>
+   struct limb_array
+   {
+      U limbs[N];
+   };
+
+   template <class T>
+   struct limb_conversion
+   {
+      typedef typename montgomery_method<boost::uint64_t>::word_type limb_type;
+      BOOST_STATIC_CONSTEXPR int bits = static_cast<int>(sizeof(limb_type) * CHAR_BIT);
+      BOOST_STATIC_CONSTEXPR std::size_t count = (std::numeric_limits<T>::digits + bits - 1) / bits;
+      typedef limb_array<limb_type, count> value_type;
+
+      static BOOST_CXX14_CONSTEXPR value_type load(const T& a)
+      {
+         value_type x = {};
+         T v = a;
+         for (std::size_t i = 0; i < count && v != T(0); ++i)
+         {
+            x.limbs[i] = static_cast<limb_type>(v & T((std::numeric_limits<limb_type>::max)()));
+            v >>= bits;
+         }
+         return x;
+      }
+      static BOOST_CXX14_CONSTEXPR T store(const value_type& x)
+      {
+         T v = 0;
+         for (std::size_t i = count; i-- > 0;)
+         {
+            v <<= bits;
+            v |= x.limbs[i];
+         }
+         return v;
+      }
+   };
+
+   // The same interface, with values held as themselves, for the types and moduli above don't cover:
+   template <class Z>
+   struct plain_multiplier
+   {
+      Z modulus;
+      Z one;
+
+      BOOST_CXX14_CONSTEXPR explicit plain_multiplier(const Z& p) : modulus(p), one(1) {}
+
+      BOOST_CXX14_CONSTEXPR Z mul(const Z& a, const Z& b) const
+      {
+         return mul_mod(a, b, modulus);
+      }
+   };
+
+   // The bit position of the leading 4-bit digit of e > 0, a multiple of 4:
+   template <class Z>
+   BOOST_CXX14_CONSTEXPR int leading_digit_shift(const Z& e)
+   {
+      const int limit = std::numeric_limits<Z>::is_bounded ? std::numeric_limits<Z>::digits : INT_MAX;
+      int shift = 0;
+      while (shift + 4 < limit && Z(e >> (shift + 4)) != Z(0))
+      {
+         shift += 4;
+      }
+      return shift;
+   }
+
+   //
+   // x^e for e > 0 with a fixed 4-bit window: a table of x^0..x^15, then four squarings and at most
+   // one multiplication per digit of e.  x and the result are in the multiplier's representation.
+   //
+   template <class Multiplier, class Z, class E>
+   BOOST_CXX14_CONSTEXPR Z window_pow(const Multiplier& mult, const Z& x, const E& e)
+   {
+      Z table[16] = {};
+      table[0] = mult.one;
+      for (int i = 1; i < 16; ++i)
+      {
+         table[i] = mult.mul(table[i - 1], x);
+      }
+      int shift = leading_digit_shift(e);
+      Z result = table[static_cast<unsigned>(E(E(e >> shift) & 15u))];
+      for (shift -= 4; shift >= 0; shift -= 4)
+      {
+         for (int i = 0; i < 4; ++i)
+         {
+            result = mult.mul(result, result);
+         }
+         unsigned digit = static_cast<unsigned>(E(E(e >> shift) & 15u));
+         if (digit != 0)
+         {
+            result = mult.mul(result, table[digit]);
+         }
+      }
+      return result;
+   }
+
+} // namespace modular_detail
+} // namespace integer
+} // namespace boost
+
+#endif // BOOST_INTEGER_DETAIL_MODULAR_MULTIPLY_HPP
@@ -9,8 +9,20 @@
 #include <limits>
 #include <stdexcept>
 #include <boost/throw_exception.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/config.hpp>
 #include <boost/core/invoke_swap.hpp>
 #include <boost/core/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_TYPE_TRAITS) && !defined(BOOST_NO_CXX11_NOEXCEPT)
+#include <type_traits>
+#define BOOST_EUCLIDEAN_NOEXCEPT(T) noexcept(std::is_arithmetic<T>::value)
+#else
+#define BOOST_EUCLIDEAN_NOEXCEPT(T)
+#endif
 
 namespace boost { namespace integer {
 
@@ -25,57 +37,706 @@ struct euclidean_result_t
     Z y;
 };
 
+// The result of extended_euclidean_x: gcd(m,n) and x, without the cofactor of n.
 template<class Z>
-typename boost::enable_if_c< std::numeric_limits< Z >::is_signed, euclidean_result_t< Z > >::type
-extended_euclidean(Z m, Z n)
+struct euclidean_x_result_t
 {
-    if (m < 1 || n < 1)
-    {
-        BOOST_THROW_EXCEPTION(std::domain_error("extended_euclidean: arguments must be strictly positive"));
-    }
+    Z gcd;
+    Z x;
+};
+
+namespace euclidean_detail {
+
+enum method_type
+{
+    method_division = 0,  // Euclid's algorithm: one division and three multiply-subtracts per step
+    method_binary = 1,    // shifts and subtractions only
+    method_lehmer = 2     // Lehmer's algorithm: most steps done on the leading word only
+};
+
+//
+// Selects the algorithm used by extended_euclidean (and mod_inverse), in the same way as
+// gcd_detail::gcd_traits<T>::method does for gcd.  The binary algorithm needs the unsigned
+// counterpart of Z, so is only available for builtin integer types.  On current x86-64 hardware
+// the division based algorithm is the faster of the two at every width (see the benchmark in the
+// documentation), so it is the default for those; specialize this to select method_binary for
+// targets with slow or missing hardware division.
+//
+// Lehmer's algorithm is the default for unbounded integer types such as cpp_int, for which each
+// division step costs a multiprecision division and three multiprecision multiply-subtracts.  It
+// needs intermediate values up to 2^62 times the operands, so is not used for fixed width types.
+//
+template<class Z>
+struct extended_euclidean_traits
+{
+    static const method_type method =
+        std::numeric_limits< Z >::is_specialized && std::numeric_limits< Z >::is_integer && !std::numeric_limits< Z >::is_bounded
+        ? method_lehmer : method_division;
+};
+
+// Rotating the rows by moving rather than copying saves allocations for heavy types:
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+template<class Z>
+BOOST_CXX14_CONSTEXPR Z&& rvalue(Z& z) BOOST_NOEXCEPT
+{
+    return static_cast<Z&&>(z);
+}
+#else
+template<class Z>
+Z& rvalue(Z& z)
+{
+    return z;
+}
+#endif
 
+// boost::core::invoke_swap is not constexpr before C++20:
+template<class Z>
+BOOST_CXX14_CONSTEXPR void constexpr_swap(Z& a, Z& b) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    Z t = rvalue(a);
+    a = rvalue(b);
+    b = rvalue(t);
+}
+
+// When want_y is false, the cofactors of n are not computed, and y is returned as zero.
+// Column 1 of the rows holds the cofactors of m and column 2 those of n, whichever of them is larger.
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR euclidean_result_t< Z > division_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
     bool swapped = false;
     if (m < n)
     {
         swapped = true;
-        boost::core::invoke_swap(m, n);
+        constexpr_swap(m, n);
     }
     Z u0 = m;
-    Z u1 = 1;
-    Z u2 = 0;
+    Z u1 = swapped ? 0 : 1;
+    Z u2 = swapped ? 1 : 0;
     Z v0 = n;
-    Z v1 = 0;
-    Z v2 = 1;
-    Z w0;
-    Z w1;
-    Z w2;
+    Z v1 = swapped ? 1 : 0;
+    Z v2 = swapped ? 0 : 1;
+    Z w0 = 0;
+    Z w1 = 0;
+    Z w2 = 0;
     while(v0 > 0)
     {
         Z q = u0/v0;
         w0 = u0 - q*v0;
         w1 = u1 - q*v1;
-        w2 = u2 - q*v2;
-        u0 = v0;
-        u1 = v1;
-        u2 = v2;
-        v0 = w0;
-        v1 = w1;
-        v2 = w2;
+        u0 = rvalue(v0);
+        u1 = rvalue(v1);
+        v0 = rvalue(w0);
+        v1 = rvalue(w1);
+        if (want_y)
+        {
+            w2 = u2 - q*v2;
+            u2 = rvalue(v2);
+            v2 = rvalue(w2);
+        }
+    }
+
+    euclidean_result_t< Z > result = { u0, u1, want_y ? u2 : Z(0) };
+    return result;
+}
+
+// The result of the extended Euclidean algorithm on unsigned Z, as magnitudes: m*x + n*y = gcd holds
+// with x negated if x_negative, and y negated otherwise (the cofactors have opposite signs unless
+// one of them is zero).
+template<class Z>
+struct unsigned_euclidean_result_t
+{
+    Z gcd;
+    Z x;
+    Z y;
+    bool x_negative;
+};
+
+// The extended Euclidean algorithm on magnitudes only, for unsigned Z.
+//
+// The cofactors of successive remainders alternate in sign, so their magnitudes obey
+// |s_{i+1}| = |s_{i-1}| + q_i |s_i| and the signs follow from the number of steps taken.
+// No intermediate exceeds max(m, n)/gcd(m, n), so nothing overflows and full-range inputs
+// work without widening.  As for division_extended_euclidean, y is only computed if want_y.
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR unsigned_euclidean_result_t< Z > division_unsigned_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    bool swapped = false;
+    if (m < n)
+    {
+        swapped = true;
+        constexpr_swap(m, n);
+    }
+    Z u0 = m;
+    Z u1 = swapped ? 0 : 1;
+    Z u2 = swapped ? 1 : 0;
+    Z v0 = n;
+    Z v1 = swapped ? 1 : 0;
+    Z v2 = swapped ? 0 : 1;
+    Z w0 = 0;
+    Z w1 = 0;
+    Z w2 = 0;
+    // Row i satisfies m*s_i + n*t_i = r_i, where s_i = (-1)^i u1 and t_i = (-1)^(i+1) u2 when the
+    // first row is m, and the signs are the other way round when it is n.
+    bool odd = false;
+    while(v0 > Z(0))
+    {
+        Z q = static_cast<Z>(u0/v0);
+        w0 = static_cast<Z>(u0 - q*v0);
+        w1 = static_cast<Z>(u1 + q*v1);
+        u0 = rvalue(v0);
+        u1 = rvalue(v1);
+        v0 = rvalue(w0);
+        v1 = rvalue(w1);
+        if (want_y)
+        {
+            w2 = static_cast<Z>(u2 + q*v2);
+            u2 = rvalue(v2);
+            v2 = rvalue(w2);
+        }
+        odd = !odd;
+    }
+
+    unsigned_euclidean_result_t< Z > result = { u0, u1, want_y ? u2 : Z(0), swapped ? !odd : odd };
+    return result;
+}
+
+// Builtin unsigned arithmetic, without promotion to int for the narrow types:
+template<class U>
+struct binary_word
+{
+    typedef typename boost::conditional< (sizeof(U) < sizeof(unsigned)), unsigned, U >::type type;
+};
+
+// x/2 mod b, for odd b and x < b, without branches:
+template<class U>
+BOOST_CXX14_CONSTEXPR inline U half_mod(U x, U b) BOOST_NOEXCEPT
+{
+    return static_cast<U>((x >> 1) + (static_cast<U>(U(0) - (x & 1u)) & static_cast<U>((b >> 1) + 1u)));
+}
+
+// (x - y) mod b, for x, y < b:
+template<class U>
+BOOST_CXX14_CONSTEXPR inline U sub_mod(U x, U y, U b) BOOST_NOEXCEPT
+{
+    U d = static_cast<U>(x - y);
+    return static_cast<U>(d + (static_cast<U>(U(0) - U(x < y)) & b));
+}
+
+// 1/b mod 2^N for odd b, N the width of the unsigned type W (at least that of unsigned), by Newton's
+// iteration: each step doubles the number of correct low bits, starting from the 5 that 3b xor 2
+// gets right, so the number of steps depends only on N.
+template<class W>
+BOOST_CXX14_CONSTEXPR inline W inverse_mod_word(W b) BOOST_NOEXCEPT
+{
+    W inv = static_cast<W>(static_cast<W>(3u * b) ^ 2u);
+    for (int bits = 5; bits < std::numeric_limits<W>::digits; bits *= 2)
+    {
+        inv = static_cast<W>(inv * static_cast<W>(2u - static_cast<W>(b * inv)));
+    }
+    return inv;
+}
+
+// Returns g = gcd(a, b) and x in [0, b) with a*x = g (mod b), for a > 0 and odd b, with the binary
+// algorithm.  Each remainder u is tracked together with its cofactor x, u = a*x (mod b); halving
+// u halves x modulo b (possible since b is odd) and subtracting remainders subtracts cofactors.
+template<class U>
+BOOST_CXX14_CONSTEXPR U binary_gcd_cofactor(U a, U b, U& x) BOOST_NOEXCEPT
+{
+    if (b == 1u)
+    {
+        x = 0;
+        return 1;
+    }
+    U u = a;
+    U v = b;
+    U x1 = 1;
+    U x2 = 0;
+    while ((u & 1u) == 0u)
+    {
+        u >>= 1;
+        x1 = half_mod(x1, b);
+    }
+    while (u != v)
+    {
+        // Both odd here, so the difference is even and nonzero:
+        if (u > v)
+        {
+            u = static_cast<U>(u - v);
+            x1 = sub_mod(x1, x2, b);
+            do
+            {
+                u >>= 1;
+                x1 = half_mod(x1, b);
+            } while ((u & 1u) == 0u);
+        }
+        else
+        {
+            v = static_cast<U>(v - u);
+            x2 = sub_mod(x2, x1, b);
+            do
+            {
+                v >>= 1;
+                x2 = half_mod(x2, b);
+            } while ((v & 1u) == 0u);
+        }
+    }
+    x = x1;
+    return u;
+}
+
+//
+// The extended binary gcd, for builtin unsigned U: no divisions in the main loop.
+//
+// After removing the common power of two, one operand, b say, is odd and the loop above finds the
+// cofactor x of the other modulo b.  Reducing that into (-b/2g, b/2g] gives the same minimal solution
+// as Euclid's algorithm, and the other cofactor then follows from a*x + b*y = g modulo 2^N, where
+// the odd b is invertible; its magnitude is at most a/2g, so the low bits determine it.
+//
+template<bool want_y, class U>
+BOOST_CXX14_CONSTEXPR unsigned_euclidean_result_t< U > binary_unsigned_extended_euclidean(U m, U n) BOOST_NOEXCEPT
+{
+    typedef typename binary_word< U >::type W;
+
+    unsigned shift = 0;
+    while (((m | n) & 1u) == 0u)
+    {
+        m >>= 1;
+        n >>= 1;
+        ++shift;
+    }
+    // Find the cofactor of whichever operand is paired with an odd one:
+    bool swapped = (n & 1u) == 0u;
+    if (swapped)
+    {
+        constexpr_swap(m, n);
+    }
+    U x = 0;
+    U g = binary_gcd_cofactor(m, n, x);
+    U period = g == 1u ? n : static_cast<U>(n / g);
+    if (g != 1u)
+    {
+        x = static_cast<U>(x % period);
+    }
+    // Minimal representative; x = 0 only when n == g, and then y = 1:
+    bool x_negative = x == 0u || x > period / 2;
+    U x_magnitude = x == 0u ? x : x_negative ? static_cast<U>(period - x) : x;
+    U y_magnitude = 0;
+    if (want_y || swapped)
+    {
+        W x_word = x_negative ? static_cast<W>(W(0) - W(x_magnitude)) : W(x_magnitude);
+        W y_word = static_cast<W>(static_cast<W>(W(g) - static_cast<W>(W(m) * x_word)) * inverse_mod_word(W(n)));
+        y_magnitude = x_negative ? static_cast<U>(y_word) : static_cast<U>(W(0) - y_word);
+    }
+
+    unsigned_euclidean_result_t< U > result = { static_cast<U>(g << shift), x_magnitude, y_magnitude, x_negative };
+    if (swapped)
+    {
+        result.x = y_magnitude;
+        result.y = x_magnitude;
+        result.x_negative = !x_negative;
+    }
+    return result;
+}
+
+// The low word of u >> shift, using scratch (whose capacity is reused) for the shifted value.
+template<class Z>
+inline boost::uint64_t lehmer_leading_word(const Z& u, int shift, Z& scratch)
+{
+    scratch = u;
+    scratch >>= shift;
+    return static_cast<boost::uint64_t>(scratch);
+}
+
+// The number of significant bits in u > 0, given an upper bound on it (which may be 0).
+template<class Z>
+int lehmer_bit_length(const Z& u, int bound, Z& scratch)
+{
+    if (bound <= 0)
+    {
+        // Find an upper bound by doubling:
+        bound = 64;
+        scratch = u;
+        scratch >>= bound;
+        while (scratch != Z(0))
+        {
+            scratch >>= bound;
+            bound *= 2;
+        }
+    }
+    // Then step down a word at a time until the word below the bound is nonzero:
+    while (bound > 64)
+    {
+        boost::uint64_t w = lehmer_leading_word(u, bound - 64, scratch);
+        if (w != 0u)
+        {
+            return bound - boost::core::countl_zero(w);
+        }
+        bound -= 64;
+    }
+    return 64 - boost::core::countl_zero(static_cast<boost::uint64_t>(u));
+}
+
+// Sets u = |a|*u + |b|*v and v = |c|*u + |d|*v in place, for cofactor magnitudes.
+template<class Z>
+void lehmer_add(Z& u, Z& v, boost::uint64_t a, boost::uint64_t b, boost::uint64_t c, boost::uint64_t d, Z& t0, Z& t1)
+{
+    t0 = u;
+    t0 *= c;
+    t1 = v;
+    t1 *= b;
+    u *= a;
+    u += t1;
+    v *= d;
+    v += t0;
+}
+
+// The rows of Lehmer's algorithm and two scratch values.
+template<class Z>
+struct lehmer_rows
+{
+    Z u0, u1, u2, v0, v1, v2, t0, t1;
+};
+
+} // namespace euclidean_detail
+
+//
+// Storage for extended_euclidean on unbounded types such as cpp_int, which use Lehmer's algorithm.
+// Passing the same workspace (and result) to repeated calls lets the algorithm reuse its storage
+// rather than allocate, as all the arithmetic is done in place.
+//
+template<class Z>
+class extended_euclidean_workspace
+{
+public:
+    // For the implementation:
+    euclidean_detail::lehmer_rows< Z >& rows() BOOST_NOEXCEPT { return rows_; }
+
+private:
+    euclidean_detail::lehmer_rows< Z > rows_;
+};
+
+namespace euclidean_detail {
+
+//
+// The extended Euclidean algorithm in Lehmer's form (Knuth, TAOCP Vol. 2, 4.5.2, Algorithm L), for
+// unbounded integer types.
+//
+// The quotient sequence is simulated on the leading 62 bits of the remainders, as long as the
+// quotients are certain to be the same as those of the full values, and the resulting 2x2 matrix
+// of single word entries is then applied to the remainders and to the cofactors at once.  Each
+// outer iteration so replaces about 30 multiprecision division steps by eight multiplications by a
+// single word.  The entries alternate in sign, and the cofactors are kept as magnitudes as in
+// division_unsigned_extended_euclidean, so all the arithmetic is on nonnegative values.  The
+// cofactors of n are only computed if want_y.
+//
+// Leaves the gcd and the magnitudes of x and y in ws.u0, ws.u1 and ws.u2, and returns whether x is
+// negative.  Rows are updated in place and rotated by swapping, so that their storage is reused.
+//
+template<bool want_y, class Z>
+bool lehmer_extended_euclidean(const Z& m, const Z& n, lehmer_rows< Z >& ws)
+{
+    Z& u0 = ws.u0;
+    Z& u1 = ws.u1;
+    Z& u2 = ws.u2;
+    Z& v0 = ws.v0;
+    Z& v1 = ws.v1;
+    Z& v2 = ws.v2;
+    bool swapped = m < n;
+    u0 = swapped ? n : m;
+    v0 = swapped ? m : n;
+    u1 = swapped ? 0 : 1;
+    u2 = swapped ? 1 : 0;
+    v1 = swapped ? 1 : 0;
+    v2 = swapped ? 0 : 1;
+    bool odd = false;
+    int bits = 0;
+    while (v0 > Z(0))
+    {
+        bits = lehmer_bit_length(u0, bits, ws.t0);
+        int shift = bits > 62 ? bits - 62 : 0;
+        boost::int64_t uh = static_cast<boost::int64_t>(lehmer_leading_word(u0, shift, ws.t0));
+        boost::int64_t vh = static_cast<boost::int64_t>(lehmer_leading_word(v0, shift, ws.t0));
+        boost::int64_t a = 1;
+        boost::int64_t b = 0;
+        boost::int64_t c = 0;
+        boost::int64_t d = 1;
+        bool steps_odd = false;
+        // The quotient of the full values lies between these two, so take it when they agree:
+        while (vh + c > 0 && vh + d > 0)
+        {
+            boost::int64_t q = (uh + a) / (vh + c);
+            if (q != (uh + b) / (vh + d))
+            {
+                break;
+            }
+            boost::int64_t t = a - q * c;
+            a = c;
+            c = t;
+            t = b - q * d;
+            b = d;
+            d = t;
+            t = uh - q * vh;
+            uh = vh;
+            vh = t;
+            steps_odd = !steps_odd;
+        }
+        if (b == 0)
+        {
+            // Not even one step could be simulated (v0 is much smaller than u0), so do a full one:
+            Z& q = ws.t1;
+            q = u0;
+            q /= v0;
+            ws.t0 = v0;
+            ws.t0 *= q;
+            u0 -= ws.t0;
+            boost::core::invoke_swap(u0, v0);
+            ws.t0 = v1;
+            ws.t0 *= q;
+            u1 += ws.t0;
+            boost::core::invoke_swap(u1, v1);
+            if (want_y)
+            {
+                ws.t0 = v2;
+                ws.t0 *= q;
+                u2 += ws.t0;
+                boost::core::invoke_swap(u2, v2);
+            }
+            odd = !odd;
+        }
+        else
+        {
+            // a and d have the sign of (-1)^steps, b and c the opposite one:
+            boost::uint64_t ma = static_cast<boost::uint64_t>(a < 0 ? -a : a);
+            boost::uint64_t mb = static_cast<boost::uint64_t>(b < 0 ? -b : b);
+            boost::uint64_t mc = static_cast<boost::uint64_t>(c < 0 ? -c : c);
+            boost::uint64_t md = static_cast<boost::uint64_t>(d < 0 ? -d : d);
+            // New u0 = a*u0 + b*v0 and v0 = c*u0 + d*v0, where one product of each pair is negative:
+            ws.t0 = u0;
+            ws.t0 *= mc;
+            ws.t1 = v0;
+            ws.t1 *= mb;
+            u0 *= ma;
+            v0 *= md;
+            if (steps_odd)
+            {
+                ws.t1 -= u0;
+                boost::core::invoke_swap(u0, ws.t1);
+                ws.t0 -= v0;
+                boost::core::invoke_swap(v0, ws.t0);
+            }
+            else
+            {
+                u0 -= ws.t1;
+                v0 -= ws.t0;
+            }
+            // The cofactors of u0 and v0 have opposite signs, so their magnitudes add:
+            lehmer_add(u1, v1, ma, mb, mc, md, ws.t0, ws.t1);
+            if (want_y)
+            {
+                lehmer_add(u2, v2, ma, mb, mc, md, ws.t0, ws.t1);
+            }
+            if (steps_odd)
+            {
+                odd = !odd;
+            }
+        }
     }
+    return swapped ? !odd : odd;
+}
+
+// Negates the magnitude of whichever cofactor is negative, without a temporary.
+template<class Z>
+void lehmer_signed_cofactors(lehmer_rows< Z >& ws, bool x_negative)
+{
+    Z& v = x_negative ? ws.u1 : ws.u2;
+    ws.t0 = 0;
+    ws.t0 -= v;
+    boost::core::invoke_swap(v, ws.t0);
+}
+
+template<bool want_y, class Z>
+unsigned_euclidean_result_t< Z > lehmer_unsigned_extended_euclidean(const Z& m, const Z& n)
+{
+    lehmer_rows< Z > ws;
+    unsigned_euclidean_result_t< Z > result;
+    result.x_negative = lehmer_extended_euclidean<want_y>(m, n, ws);
+    boost::core::invoke_swap(result.gcd, ws.u0);
+    boost::core::invoke_swap(result.x, ws.u1);
+    boost::core::invoke_swap(result.y, ws.u2);
+    return result;
+}
+
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_division, unsigned_euclidean_result_t< Z > >::type
+unsigned_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    return division_unsigned_extended_euclidean<want_y>(m, n);
+}
+
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_binary, unsigned_euclidean_result_t< Z > >::type
+unsigned_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    return binary_unsigned_extended_euclidean<want_y>(m, n);
+}
+
+template<bool want_y, class Z>
+typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_lehmer, unsigned_euclidean_result_t< Z > >::type
+unsigned_extended_euclidean(Z m, Z n)
+{
+    return lehmer_unsigned_extended_euclidean<want_y>(m, n);
+}
+
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_division, euclidean_result_t< Z > >::type
+signed_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    return division_extended_euclidean<want_y>(m, n);
+}
+
+template<bool want_y, class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_binary, euclidean_result_t< Z > >::type
+signed_extended_euclidean(Z m, Z n) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    typedef typename boost::make_unsigned< Z >::type U;
+    unsigned_euclidean_result_t< U > u = binary_unsigned_extended_euclidean<want_y>(static_cast<U>(m), static_cast<U>(n));
+    euclidean_result_t< Z > result = {
+        static_cast<Z>(u.gcd),
+        u.x_negative ? static_cast<Z>(-static_cast<Z>(u.x)) : static_cast<Z>(u.x),
+        u.x_negative ? static_cast<Z>(u.y) : static_cast<Z>(-static_cast<Z>(u.y)) };
+    return result;
+}
 
+template<bool want_y, class Z>
+typename boost::enable_if_c< extended_euclidean_traits< Z >::method == method_lehmer, euclidean_result_t< Z > >::type
+signed_extended_euclidean(Z m, Z n)
+{
+    lehmer_rows< Z > ws;
+    lehmer_signed_cofactors(ws, lehmer_extended_euclidean<want_y>(m, n, ws));
     euclidean_result_t< Z > result;
-    result.gcd = u0;
-    if (!swapped)
+    boost::core::invoke_swap(result.gcd, ws.u0);
+    boost::core::invoke_swap(result.x, ws.u1);
+    boost::core::invoke_swap(result.y, ws.u2);
+    return result;
+}
+
+} // namespace euclidean_detail
+
+//
+// Non-throwing forms, usable in constant expressions for builtin types: these return false, with
+// all members of result zero, unless both arguments are strictly positive.
+//
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean(Z m, Z n, euclidean_result_t< Z >& result) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    if (m < 1 || n < 1)
     {
-        result.x = u1;
-        result.y = u2;
+        result.gcd = result.x = result.y = Z(0);
+        return false;
     }
-    else
+    result = euclidean_detail::signed_extended_euclidean<true>(m, n);
+    return true;
+}
+
+// Unsigned types: the cofactors are returned reduced modulo 2^digits, so that m*x + n*y = gcd(m,n)
+// holds in the (wrapping) arithmetic of Z.  Since |x| <= max(1, n/(2 gcd)) and |y| <= max(1, m/(2 gcd)),
+// a cofactor above (max)()/2 is the two's complement of a negative value, and converting it to the
+// corresponding signed type recovers that value.
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< !std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean(Z m, Z n, euclidean_result_t< Z >& result) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    if (m == Z(0) || n == Z(0))
     {
-        result.x = u2;
-        result.y = u1;
+        result.gcd = result.x = result.y = Z(0);
+        return false;
     }
+    euclidean_detail::unsigned_euclidean_result_t< Z > u = euclidean_detail::unsigned_extended_euclidean<true>(m, n);
+    result.gcd = u.gcd;
+    result.x = u.x_negative ? static_cast<Z>(Z(0) - u.x) : u.x;
+    result.y = u.x_negative ? u.y : static_cast<Z>(Z(0) - u.y);
+    return true;
+}
 
+template<class Z>
+BOOST_CXX14_CONSTEXPR euclidean_result_t< Z > extended_euclidean(Z m, Z n)
+{
+    euclidean_result_t< Z > result = { Z(0), Z(0), Z(0) };
+    if (!extended_euclidean(m, n, result))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("extended_euclidean: arguments must be strictly positive"));
+    }
+    return result;
+}
+
+// As the non-throwing form, but using (and reusing) the storage of workspace and result.  Only
+// types using Lehmer's algorithm benefit; for the others the workspace is unused.
+template<class Z>
+typename boost::enable_if_c< euclidean_detail::extended_euclidean_traits< Z >::method == euclidean_detail::method_lehmer && std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean(const Z& m, const Z& n, euclidean_result_t< Z >& result, extended_euclidean_workspace< Z >& workspace)
+{
+    if (m < 1 || n < 1)
+    {
+        result.gcd = result.x = result.y = Z(0);
+        return false;
+    }
+    euclidean_detail::lehmer_rows< Z >& ws = workspace.rows();
+    euclidean_detail::lehmer_signed_cofactors(ws, euclidean_detail::lehmer_extended_euclidean<true>(m, n, ws));
+    // Swapping hands the result's previous storage to the workspace for the next call:
+    boost::core::invoke_swap(result.gcd, ws.u0);
+    boost::core::invoke_swap(result.x, ws.u1);
+    boost::core::invoke_swap(result.y, ws.u2);
+    return true;
+}
+
+template<class Z>
+typename boost::enable_if_c< euclidean_detail::extended_euclidean_traits< Z >::method != euclidean_detail::method_lehmer || !std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean(const Z& m, const Z& n, euclidean_result_t< Z >& result, extended_euclidean_workspace< Z >&)
+{
+    return extended_euclidean(m, n, result);
+}
+
+// As extended_euclidean, but computes only the cofactor x of m, which is all that is needed for
+// modular inverses, saving the multiply-adds which produce y.
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean_x(Z m, Z n, euclidean_x_result_t< Z >& result) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    if (m < 1 || n < 1)
+    {
+        result.gcd = result.x = Z(0);
+        return false;
+    }
+    euclidean_result_t< Z > u = euclidean_detail::signed_extended_euclidean<false>(m, n);
+    result.gcd = u.gcd;
+    result.x = u.x;
+    return true;
+}
+
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< !std::numeric_limits< Z >::is_signed, bool >::type
+extended_euclidean_x(Z m, Z n, euclidean_x_result_t< Z >& result) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    if (m == Z(0) || n == Z(0))
+    {
+        result.gcd = result.x = Z(0);
+        return false;
+    }
+    euclidean_detail::unsigned_euclidean_result_t< Z > u = euclidean_detail::unsigned_extended_euclidean<false>(m, n);
+    result.gcd = u.gcd;
+    result.x = u.x_negative ? static_cast<Z>(Z(0) - u.x) : u.x;
+    return true;
+}
+
+template<class Z>
+BOOST_CXX14_CONSTEXPR euclidean_x_result_t< Z > extended_euclidean_x(Z m, Z n)
+{
+    euclidean_x_result_t< Z > result = { Z(0), Z(0) };
+    if (!extended_euclidean_x(m, n, result))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("extended_euclidean_x: arguments must be strictly positive"));
+    }
     return result;
 }
 
@@ -0,0 +1,190 @@
+//  Boost gcd_accumulator.hpp header file  -----------------------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_GCD_ACCUMULATOR_HPP
+#define BOOST_INTEGER_GCD_ACCUMULATOR_HPP
+
+#include <boost/integer_fwd.hpp>  // self include
+#include <boost/integer/common_factor_rt.hpp>
+#include <cstddef>
+#include <limits>
+
+namespace boost {
+namespace integer {
+
+namespace gcd_detail {
+
+   //
+   // The accumulators hold magnitudes.  That of the minimum of a signed type has no representation,
+   // so it is held as the minimum itself, which is what gcd returns for it.  gcd divides by zero
+   // for gcd(0, min), gcd(min, 0) and gcd(min, min), so zero and the minimum are dealt with here.
+   //
+   template <class T>
+   BOOST_CXX14_CONSTEXPR bool accumulator_is_min(const T& x) BOOST_GCD_NOEXCEPT(T)
+   {
+      return std::numeric_limits<T>::is_signed && std::numeric_limits<T>::is_bounded && x == (std::numeric_limits<T>::min)();
+   }
+
+   template <class T>
+   BOOST_CXX14_CONSTEXPR T accumulator_magnitude(const T& x) BOOST_GCD_NOEXCEPT(T)
+   {
+      return accumulator_is_min(x) ? x : static_cast<T>(gcd_traits<T>::abs(x));
+   }
+
+   // gcd of a held magnitude a and any b:
+   template <class T>
+   BOOST_CXX14_CONSTEXPR T accumulator_gcd(const T& a, const T& b) BOOST_GCD_NOEXCEPT(T)
+   {
+      if (a == T(0))
+         return accumulator_magnitude(b);
+      if (b == T(0) || (accumulator_is_min(a) && accumulator_is_min(b)))
+         return a;
+      return boost::integer::gcd(a, b);
+   }
+
+   // lcm of a held magnitude a and any b; the result is the minimum when the lcm is its magnitude,
+   // and otherwise overflows exactly when lcm would:
+   template <class T>
+   BOOST_CXX14_CONSTEXPR T accumulator_lcm(const T& a, const T& b) BOOST_GCD_NOEXCEPT(T)
+   {
+      if (!accumulator_is_min(a) && !accumulator_is_min(b))
+         return boost::integer::lcm(a, b);
+      if (a == T(0) || b == T(0))
+         return T(0);
+      const T m = accumulator_is_min(a) ? a : b;
+      const T other = accumulator_is_min(a) ? accumulator_magnitude(b) : a;
+      return static_cast<T>(other / accumulator_gcd(m, other) * m);
+   }
+
+} // namespace gcd_detail
+
+//
+// Streaming versions of gcd_range and lcm_range: values are pushed one at a time
+// (or in batches) and partial results computed on different threads can be merged,
+// since gcd and lcm are both associative and commutative.
+//
+// An empty gcd_accumulator holds 0 and an empty lcm_accumulator holds 1, which are
+// the identity elements of the respective operations.  A result whose magnitude does
+// not fit a signed type, as for gcd(0, INT_MIN), is held as the minimum of the type.  Once a gcd_accumulator
+// reaches 1, or an lcm_accumulator reaches 0, no further input can change the
+// result and the accumulator is said to be saturated: producers may stop early.
+//
+template <typename IntegerType>
+class gcd_accumulator
+{
+public:
+   typedef IntegerType value_type;
+
+   BOOST_CXX14_CONSTEXPR gcd_accumulator() BOOST_GCD_NOEXCEPT(IntegerType) : m_value(0) {}
+   explicit BOOST_CXX14_CONSTEXPR gcd_accumulator(IntegerType const& initial) BOOST_GCD_NOEXCEPT(IntegerType)
+      : m_value(gcd_detail::accumulator_magnitude(initial)) {}
+
+   BOOST_CXX14_CONSTEXPR void push(IntegerType const& x) BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      if (!saturated())
+         m_value = gcd_detail::accumulator_gcd(m_value, x);
+   }
+
+   //
+   // Consumes [first, last) until either the range is exhausted or the accumulator
+   // saturates, returns the position at which consumption stopped (as gcd_range does).
+   //
+   template <typename I>
+   I push_batch(I first, I last)
+   {
+      while (!saturated() && first != last)
+      {
+         m_value = gcd_detail::accumulator_gcd(m_value, static_cast<IntegerType>(*first));
+         ++first;
+      }
+      return first;
+   }
+   const IntegerType* push_batch(const IntegerType* p, std::size_t n)
+   {
+      return push_batch(p, p + n);
+   }
+
+   BOOST_CXX14_CONSTEXPR void merge(gcd_accumulator const& other) BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      push(other.m_value);
+   }
+
+   BOOST_CXX14_CONSTEXPR bool saturated() const BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return m_value == IntegerType(1);
+   }
+   BOOST_CXX14_CONSTEXPR IntegerType const& value() const BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return m_value;
+   }
+   BOOST_CXX14_CONSTEXPR void reset() BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      m_value = IntegerType(0);
+   }
+
+private:
+   IntegerType m_value;
+};
+
+template <typename IntegerType>
+class lcm_accumulator
+{
+public:
+   typedef IntegerType value_type;
+
+   BOOST_CXX14_CONSTEXPR lcm_accumulator() BOOST_GCD_NOEXCEPT(IntegerType) : m_value(1) {}
+   explicit BOOST_CXX14_CONSTEXPR lcm_accumulator(IntegerType const& initial) BOOST_GCD_NOEXCEPT(IntegerType)
+      : m_value(gcd_detail::accumulator_magnitude(initial)) {}
+
+   BOOST_CXX14_CONSTEXPR void push(IntegerType const& x) BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      if (!saturated())
+         m_value = gcd_detail::accumulator_lcm(m_value, x);
+   }
+
+   template <typename I>
+   I push_batch(I first, I last)
+   {
+      while (!saturated() && first != last)
+      {
+         m_value = gcd_detail::accumulator_lcm(m_value, static_cast<IntegerType>(*first));
+         ++first;
+      }
+      return first;
+   }
+   const IntegerType* push_batch(const IntegerType* p, std::size_t n)
+   {
+      return push_batch(p, p + n);
+   }
+
+   BOOST_CXX14_CONSTEXPR void merge(lcm_accumulator const& other) BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      push(other.m_value);
+   }
+
+   BOOST_CXX14_CONSTEXPR bool saturated() const BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return m_value == IntegerType(0);
+   }
+   BOOST_CXX14_CONSTEXPR IntegerType const& value() const BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      return m_value;
+   }
+   BOOST_CXX14_CONSTEXPR void reset() BOOST_GCD_NOEXCEPT(IntegerType)
+   {
+      m_value = IntegerType(1);
+   }
+
+private:
+   IntegerType m_value;
+};
+
+}  // namespace integer
+}  // namespace boost
+
+#endif  // BOOST_INTEGER_GCD_ACCUMULATOR_HPP
@@ -0,0 +1,160 @@
+//  Boost gcd_cache.hpp header file  -----------------------------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_GCD_CACHE_HPP
+#define BOOST_INTEGER_GCD_CACHE_HPP
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_HDR_MUTEX) || defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) || defined(BOOST_NO_CXX11_SMART_PTR)
+#error "boost/integer/gcd_cache.hpp requires C++11 <mutex>, <functional> and <memory>."
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/integer/common_factor_rt.hpp>
+#include <boost/integer/gcd_accumulator.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace integer {
+
+struct gcd_cache_statistics
+{
+   boost::uintmax_t hits;
+   boost::uintmax_t misses;
+   boost::uintmax_t evictions;  // insertions which displaced a different operand pair
+};
+
+//
+// A fixed capacity, memoising front end to boost::integer::gcd, for workloads which
+// repeatedly ask for the gcd of the same operand pairs (typically with multiprecision
+// types where a hash lookup is far cheaper than the gcd itself).
+//
+// The table is split into independently locked shards, each of which is a direct-mapped
+// table of capacity / shards slots, so memory use is bounded at construction and
+// concurrent callers only contend when they hash to the same shard.  The gcd itself is
+// computed outside of any lock.
+//
+template <typename IntegerType, typename Hash = std::hash<IntegerType> >
+class gcd_cache
+{
+public:
+   typedef IntegerType value_type;
+
+   explicit gcd_cache(std::size_t capacity, std::size_t shards = 16, Hash const& h = Hash())
+      : m_hash(h), m_shard_count(shards ? shards : 1), m_slots_per_shard(capacity / m_shard_count ? capacity / m_shard_count : 1),
+        m_shards(new shard[m_shard_count])
+   {
+      for (std::size_t i = 0; i < m_shard_count; ++i)
+         m_shards[i].slots.resize(m_slots_per_shard);
+   }
+
+   IntegerType operator()(IntegerType const& a, IntegerType const& b)
+   {
+      // gcd is symmetric and ignores signs, so canonicalise the key to improve the hit rate.  The
+      // minimum of a signed type has no representable magnitude and is kept as it is, which gcd
+      // also returns for it, and the gcd is taken by the path which accepts it alongside zero:
+      IntegerType u(gcd_detail::accumulator_magnitude(a));
+      IntegerType v(gcd_detail::accumulator_magnitude(b));
+      if (gcd_detail::gcd_traits<IntegerType>::less(v, u))
+         gcd_detail::constexpr_swap(u, v);
+
+      std::size_t h = m_hash(u);
+      h ^= m_hash(v) + 0x9e3779b9u + (h << 6) + (h >> 2);
+      shard& s = m_shards[h % m_shard_count];
+      entry& e = s.slots[(h / m_shard_count) % m_slots_per_shard];
+      {
+         std::lock_guard<std::mutex> lock(s.mutex);
+         if (e.occupied && e.a == u && e.b == v)
+         {
+            ++s.stats.hits;
+            return e.result;
+         }
+         ++s.stats.misses;
+      }
+      IntegerType result(gcd_detail::accumulator_gcd(u, v));
+      {
+         std::lock_guard<std::mutex> lock(s.mutex);
+         if (e.occupied && !(e.a == u && e.b == v))
+            ++s.stats.evictions;
+         e.a = u;
+         e.b = v;
+         e.result = result;
+         e.occupied = true;
+      }
+      return result;
+   }
+
+   std::size_t capacity() const BOOST_NOEXCEPT { return m_shard_count * m_slots_per_shard; }
+   std::size_t shard_count() const BOOST_NOEXCEPT { return m_shard_count; }
+
+   gcd_cache_statistics statistics(std::size_t shard_index) const
+   {
+      BOOST_ASSERT(shard_index < m_shard_count);
+      std::lock_guard<std::mutex> lock(m_shards[shard_index].mutex);
+      return m_shards[shard_index].stats;
+   }
+   gcd_cache_statistics statistics() const
+   {
+      gcd_cache_statistics total = { 0, 0, 0 };
+      for (std::size_t i = 0; i < m_shard_count; ++i)
+      {
+         gcd_cache_statistics s = statistics(i);
+         total.hits += s.hits;
+         total.misses += s.misses;
+         total.evictions += s.evictions;
+      }
+      return total;
+   }
+
+   void clear()
+   {
+      for (std::size_t i = 0; i < m_shard_count; ++i)
+      {
+         std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+         for (std::size_t j = 0; j < m_slots_per_shard; ++j)
+            m_shards[i].slots[j] = entry();
+         gcd_cache_statistics zero = { 0, 0, 0 };
+         m_shards[i].stats = zero;
+      }
+   }
+
+private:
+   gcd_cache(gcd_cache const&);
+   gcd_cache& operator=(gcd_cache const&);
+
+   struct entry
+   {
+      entry() : a(), b(), result(), occupied(false) {}
+      IntegerType a;
+      IntegerType b;
+      IntegerType result;
+      bool occupied;
+   };
+   struct shard
+   {
+      shard() { gcd_cache_statistics zero = { 0, 0, 0 }; stats = zero; }
+      mutable std::mutex mutex;
+      std::vector<entry> slots;
+      gcd_cache_statistics stats;
+   };
+
+   Hash m_hash;
+   std::size_t m_shard_count;
+   std::size_t m_slots_per_shard;
+   std::unique_ptr<shard[]> m_shards;
+};
+
+}  // namespace integer
+}  // namespace boost
+
+#endif  // BOOST_INTEGER_GCD_CACHE_HPP
@@ -0,0 +1,329 @@
+//  Boost gcd_instrumentation.hpp header file  -------------------------------//
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//  See https://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_INTEGER_GCD_INSTRUMENTATION_HPP
+#define BOOST_INTEGER_GCD_INSTRUMENTATION_HPP
+
+//
+// An instrumentation policy for the gcd algorithms in <boost/integer/common_factor_rt.hpp> which
+// records, for every call, how many loop iterations, %= operations and bits of shifting were
+// performed, into per-thread histograms.  To use it, define
+//
+//    BOOST_INTEGER_GCD_INSTRUMENTATION=boost::integer::gcd_histogram_instrumentation
+//
+// consistently for the whole program, and include this header before any other Boost.Integer
+// header.  When instrumented, the gcd functions are no longer usable in constant expressions.
+//
+
+#include <boost/config.hpp>
+
+#if defined(BOOST_NO_CXX11_THREAD_LOCAL) || defined(BOOST_NO_CXX11_HDR_ATOMIC) || defined(BOOST_NO_CXX11_HDR_MUTEX)
+#error "boost/integer/gcd_instrumentation.hpp requires C++11 thread_local, <atomic> and <mutex>."
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/integer/detail/gcd_tuning.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace boost {
+namespace integer {
+
+//
+// Bucket 0 counts calls for which the counter was zero, and bucket k > 0 calls for which it was
+// in [2^(k-1), 2^k), with the last bucket also taking everything larger.
+//
+BOOST_STATIC_CONSTEXPR std::size_t gcd_histogram_buckets = 24;
+
+struct gcd_counter_histogram
+{
+   boost::uintmax_t total;  // sum of the counter over all calls
+   boost::uintmax_t max;    // largest value seen in a single call
+   boost::uintmax_t buckets[gcd_histogram_buckets];
+};
+
+struct gcd_method_histograms
+{
+   boost::uintmax_t calls;
+   gcd_counter_histogram iterations;
+   gcd_counter_histogram modulos;
+   gcd_counter_histogram shifts;
+};
+
+struct gcd_histograms
+{
+   // Indexed by gcd_detail::method_type: method_euclid, method_binary and method_mixed.
+   gcd_method_histograms method[3];
+};
+
+class gcd_histogram_instrumentation
+{
+public:
+   // The hooks called by the gcd algorithms:
+   static void begin(gcd_detail::method_type m) BOOST_NOEXCEPT
+   {
+      thread_record& r = local();
+      r.flush();
+      r.current = m;
+   }
+   static void iteration() BOOST_NOEXCEPT { ++local().pending[0]; }
+   static void modulo() BOOST_NOEXCEPT { ++local().pending[1]; }
+   static void shift(unsigned n) BOOST_NOEXCEPT { local().pending[2] += n; }
+
+   //
+   // Export.  thread_histograms() covers calls made so far by the calling thread, histograms() the
+   // sum over all threads, including those which have exited.  The most recent call made by each
+   // other running thread is only included once that thread makes another call.
+   //
+   static gcd_histograms thread_histograms() BOOST_NOEXCEPT
+   {
+      thread_record& r = local();
+      r.flush();
+      gcd_histograms result = gcd_histograms();
+      r.data.add_to(result);
+      return result;
+   }
+   static gcd_histograms histograms()
+   {
+      local().flush();
+      registry& reg = get_registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      gcd_histograms result = gcd_histograms();
+      reg.retired.add_to(result);
+      for (std::size_t i = 0; i < reg.live.size(); ++i)
+         reg.live[i]->data.add_to(result);
+      return result;
+   }
+   // Discards everything recorded by the calling thread.
+   static void reset_thread() BOOST_NOEXCEPT
+   {
+      thread_record& r = local();
+      r.current = -1;
+      r.pending[0] = r.pending[1] = r.pending[2] = 0;
+      r.data.clear();
+   }
+   // Discards everything recorded by all threads; concurrently running calls may be partly lost.
+   static void reset()
+   {
+      reset_thread();
+      registry& reg = get_registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.retired.clear();
+      for (std::size_t i = 0; i < reg.live.size(); ++i)
+         reg.live[i]->data.clear();
+   }
+   // Writes histograms() as plain text, one line per non-empty histogram.
+   static void dump(std::ostream& os) { dump(os, histograms()); }
+   static void dump(std::ostream& os, const gcd_histograms& h)
+   {
+      static const char* const names[3] = { "euclid", "binary", "mixed" };
+      for (int m = 0; m < 3; ++m)
+      {
+         const gcd_method_histograms& mh = h.method[m];
+         if (mh.calls == 0)
+            continue;
+         os << names[m] << " calls " << mh.calls << "\n";
+         dump_counter(os, names[m], "iterations", mh.iterations);
+         dump_counter(os, names[m], "modulos", mh.modulos);
+         dump_counter(os, names[m], "shifts", mh.shifts);
+      }
+   }
+
+private:
+   static void dump_counter(std::ostream& os, const char* method, const char* counter, const gcd_counter_histogram& c)
+   {
+      os << method << ' ' << counter << " total " << c.total << " max " << c.max << " buckets";
+      std::size_t last = gcd_histogram_buckets;
+      while (last > 1 && c.buckets[last - 1] == 0)
+         --last;
+      for (std::size_t i = 0; i < last; ++i)
+         os << ' ' << c.buckets[i];
+      os << "\n";
+   }
+
+   static std::size_t bucket_of(boost::uintmax_t n) BOOST_NOEXCEPT
+   {
+      std::size_t b = 0;
+      while (n)
+      {
+         ++b;
+         n >>= 1;
+      }
+      return (std::min)(b, gcd_histogram_buckets - 1);
+   }
+
+   //
+   // Counters are only ever written by the owning thread, but may be read by any thread
+   // exporting the histograms, hence relaxed atomics with plain load/store increments.
+   //
+   typedef std::atomic<boost::uintmax_t> counter_type;
+
+   static void bump(counter_type& c, boost::uintmax_t n) BOOST_NOEXCEPT
+   {
+      c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+   }
+
+   struct atomic_counter_histogram
+   {
+      counter_type total;
+      counter_type max;
+      counter_type buckets[gcd_histogram_buckets];
+
+      void record(boost::uintmax_t n) BOOST_NOEXCEPT
+      {
+         bump(total, n);
+         if (n > max.load(std::memory_order_relaxed))
+            max.store(n, std::memory_order_relaxed);
+         bump(buckets[bucket_of(n)], 1);
+      }
+      void add_to(gcd_counter_histogram& h) const BOOST_NOEXCEPT
+      {
+         h.total += total.load(std::memory_order_relaxed);
+         h.max = (std::max)(h.max, max.load(std::memory_order_relaxed));
+         for (std::size_t i = 0; i < gcd_histogram_buckets; ++i)
+            h.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+      }
+      void merge(const atomic_counter_histogram& other) BOOST_NOEXCEPT
+      {
+         bump(total, other.total.load(std::memory_order_relaxed));
+         boost::uintmax_t m = other.max.load(std::memory_order_relaxed);
+         if (m > max.load(std::memory_order_relaxed))
+            max.store(m, std::memory_order_relaxed);
+         for (std::size_t i = 0; i < gcd_histogram_buckets; ++i)
+            bump(buckets[i], other.buckets[i].load(std::memory_order_relaxed));
+      }
+      void clear() BOOST_NOEXCEPT
+      {
+         total.store(0, std::memory_order_relaxed);
+         max.store(0, std::memory_order_relaxed);
+         for (std::size_t i = 0; i < gcd_histogram_buckets; ++i)
+            buckets[i].store(0, std::memory_order_relaxed);
+      }
+   };
+
+   struct atomic_method_histograms
+   {
+      counter_type calls;
+      atomic_counter_histogram counters[3];  // iterations, modulos, shifts
+   };
+
+   struct atomic_histograms
+   {
+      atomic_histograms() BOOST_NOEXCEPT { clear(); }
+
+      atomic_method_histograms method[3];
+
+      void add_to(gcd_histograms& h) const BOOST_NOEXCEPT
+      {
+         for (int m = 0; m < 3; ++m)
+         {
+            h.method[m].calls += method[m].calls.load(std::memory_order_relaxed);
+            method[m].counters[0].add_to(h.method[m].iterations);
+            method[m].counters[1].add_to(h.method[m].modulos);
+            method[m].counters[2].add_to(h.method[m].shifts);
+         }
+      }
+      void merge(const atomic_histograms& other) BOOST_NOEXCEPT
+      {
+         for (int m = 0; m < 3; ++m)
+         {
+            bump(method[m].calls, other.method[m].calls.load(std::memory_order_relaxed));
+            for (int c = 0; c < 3; ++c)
+               method[m].counters[c].merge(other.method[m].counters[c]);
+         }
+      }
+      void clear() BOOST_NOEXCEPT
+      {
+         for (int m = 0; m < 3; ++m)
+         {
+            method[m].calls.store(0, std::memory_order_relaxed);
+            for (int c = 0; c < 3; ++c)
+               method[m].counters[c].clear();
+         }
+      }
+   };
+
+   struct thread_record;
+
+   struct registry
+   {
+      std::mutex mutex;
+      std::vector<thread_record*> live;
+      atomic_histograms retired;  // merged in from threads which have exited
+   };
+
+   static registry& get_registry()
+   {
+      static registry r;
+      return r;
+   }
+
+   struct thread_record
+   {
+      thread_record() BOOST_NOEXCEPT : current(-1), registered(false)
+      {
+         pending[0] = pending[1] = pending[2] = 0;
+         try
+         {
+            registry& reg = get_registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.live.push_back(this);
+            registered = true;
+         }
+         catch (...)
+         {
+            // Out of memory: this thread's counts are still available from thread_histograms().
+         }
+      }
+      ~thread_record()
+      {
+         if (!registered)
+            return;
+         flush();
+         registry& reg = get_registry();
+         std::lock_guard<std::mutex> lock(reg.mutex);
+         reg.retired.merge(data);
+         reg.live.erase(std::find(reg.live.begin(), reg.live.end(), this));
+      }
+
+      // Moves the counts for the call in progress (if any) into the histograms.
+      void flush() BOOST_NOEXCEPT
+      {
+         if (current < 0)
+            return;
+         atomic_method_histograms& mh = data.method[current];
+         bump(mh.calls, 1);
+         for (int c = 0; c < 3; ++c)
+         {
+            mh.counters[c].record(pending[c]);
+            pending[c] = 0;
+         }
+         current = -1;
+      }
+
+      int current;  // method of the call in progress, or -1
+      boost::uintmax_t pending[3];
+      bool registered;
+      atomic_histograms data;
+   };
+
+   static thread_record& local() BOOST_NOEXCEPT
+   {
+      static thread_local thread_record r;
+      return r;
+   }
+};
+
+}  // namespace integer
+}  // namespace boost
+
+#endif  // BOOST_INTEGER_GCD_INSTRUMENTATION_HPP
@@ -25,6 +25,7 @@
 #include <boost/core/enable_if.hpp>
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/make_unsigned.hpp>
+#include <boost/integer/detail/bit_int.hpp>
 
 namespace boost {
 namespace detail {
@@ -99,6 +100,31 @@ inline int integer_log2_impl(boost::int128_type x)
 }
 #endif // defined(BOOST_HAS_INT128)
 
+#if defined(BOOST_INTEGER_HAS_BITINT)
+// _BitInt(N) is neither an integral type to boost/core/bit.hpp nor given std::numeric_limits,
+// so look for the most significant nonzero 64-bit limb and scan that.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wbit-int-extension"
+template< int N >
+inline int integer_log2_impl(unsigned _BitInt(N) x)
+{
+    for (int shift = ((N - 1) / 64) * 64; shift > 0; shift -= 64)
+    {
+        const boost::uint64_t limb = static_cast< boost::uint64_t >(x >> shift);
+        if (limb != 0u)
+            return shift + 63 - boost::core::countl_zero(limb);
+    }
+    return 63 - boost::core::countl_zero(static_cast< boost::uint64_t >(x));
+}
+
+template< int N >
+inline int integer_log2_impl(_BitInt(N) x)
+{
+    return detail::integer_log2_impl(static_cast< unsigned _BitInt(N) >(x));
+}
+#pragma clang diagnostic pop
+#endif // defined(BOOST_INTEGER_HAS_BITINT)
+
 } // namespace detail
 
 
@@ -8,10 +8,91 @@
 #define BOOST_INTEGER_MOD_INVERSE_HPP
 #include <stdexcept>
 #include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_integral.hpp>
 #include <boost/integer/extended_euclidean.hpp>
 
 namespace boost { namespace integer {
 
+namespace euclidean_detail {
+
+// Both take 0 < |a| < modulus.
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< std::numeric_limits< Z >::is_signed, Z >::type
+mod_inverse_imp(Z a, Z modulus) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    if (a < Z(0))
+    {
+        a += modulus;
+    }
+    boost::integer::euclidean_result_t<Z> u = signed_extended_euclidean<false>(a, modulus);
+    if (u.gcd > Z(1))
+    {
+        return Z(0);
+    }
+    // x might not be in the range 0 < x < m, let's fix that:
+    while (u.x <= Z(0))
+    {
+        u.x += modulus;
+    }
+    // While indeed this is an inexpensive and comforting check,
+    // the multiplication overflows and hence makes the check itself buggy.
+    //BOOST_ASSERT(u.x*a % modulus == 1);
+    return u.x;
+}
+
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< !std::numeric_limits< Z >::is_signed, Z >::type
+mod_inverse_imp(Z a, Z modulus) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    // The magnitude of the cofactor is less than the modulus, so one subtraction normalises it:
+    unsigned_euclidean_result_t<Z> u = unsigned_extended_euclidean<false>(a, modulus);
+    if (u.gcd > Z(1))
+    {
+        return Z(0);
+    }
+    return u.x_negative ? static_cast<Z>(modulus - u.x) : u.x;
+}
+
+// The unsigned type in which inverse_mod_pow2 works for a bounded type T, if there is one: that of
+// the same width for builtin types (but no narrower than unsigned), and T itself for fixed width
+// unsigned multiprecision types, whose arithmetic also wraps modulo 2^N.
+template<class T, bool builtin = boost::is_integral<T>::value>
+struct pow2_word
+{
+    static const bool value = std::numeric_limits<T>::is_bounded && !std::numeric_limits<T>::is_signed;
+    typedef T type;
+};
+
+template<class T>
+struct pow2_word<T, true>
+{
+    static const bool value = true;
+    typedef typename binary_word< typename boost::make_unsigned<T>::type >::type type;
+};
+
+} // namespace euclidean_detail
+
+// The non-throwing form, usable in constant expressions for builtin types: returns false, with
+// result zero, if modulus < 2 or a has no inverse modulo modulus.
+template<class Z>
+BOOST_CXX14_CONSTEXPR bool mod_inverse(Z a, Z modulus, Z& result) BOOST_EUCLIDEAN_NOEXCEPT(Z)
+{
+    result = Z(0);
+    if (modulus < Z(2))
+    {
+        return false;
+    }
+    // make sure |a| < modulus:
+    a = a % modulus;
+    if (a == Z(0))
+    {
+        // a doesn't have a modular multiplicative inverse:
+        return false;
+    }
+    result = euclidean_detail::mod_inverse_imp(a, modulus);
+    return result != Z(0);
+}
+
 // From "The Joy of Factoring", Algorithm 2.7.
 // Here's some others names I've found for this function:
 // PowerMod[a, -1, m] (Mathematica)
@@ -20,33 +101,82 @@ namespace boost { namespace integer {
 // Would mod_inverse be sometimes mistaken as the modular *additive* inverse?
 // In any case, I think this is the best name we can get for this function without agonizing.
 template<class Z>
-Z mod_inverse(Z a, Z modulus)
+BOOST_CXX14_CONSTEXPR Z mod_inverse(Z a, Z modulus)
 {
     if (modulus < Z(2))
     {
         BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse: modulus must be > 1"));
     }
-    // make sure a < modulus:
-    a = a % modulus;
-    if (a == Z(0))
+    Z result = Z(0);
+    mod_inverse(a, modulus, result);
+    return result;
+}
+
+// 1/a mod 2^N, N the width of T, as needed by Montgomery multiplication and exact division: for odd
+// a, the x with a*x == 1 in the wrapping arithmetic of T.  Returns zero for even a.  Supports builtin
+// integers, including 128-bit ones, and fixed width unsigned multiprecision types.
+template<class T>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< euclidean_detail::pow2_word< T >::value, T >::type
+inverse_mod_pow2(T a) BOOST_EUCLIDEAN_NOEXCEPT(T)
+{
+    typedef typename euclidean_detail::pow2_word< T >::type W;
+    if ((a & 1u) == 0u)
     {
-        // a doesn't have a modular multiplicative inverse:
-        return Z(0);
+        return T(0);
     }
-    boost::integer::euclidean_result_t<Z> u = boost::integer::extended_euclidean(a, modulus);
-    if (u.gcd > Z(1))
+    return static_cast<T>(euclidean_detail::inverse_mod_word(static_cast<W>(a)));
+}
+
+// 1/a mod 2^k, in [0, 2^k), or zero for even a.  Throws std::domain_error unless 0 < k and, for
+// bounded types, k <= std::numeric_limits<T>::digits.
+template<class T>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< euclidean_detail::pow2_word< T >::value, T >::type
+inverse_mod_pow2(const T& a, unsigned k)
+{
+    typedef typename euclidean_detail::pow2_word< T >::type W;
+    if (k == 0 || k > static_cast<unsigned>(std::numeric_limits<T>::digits))
     {
-        return Z(0);
+        BOOST_THROW_EXCEPTION(std::domain_error("inverse_mod_pow2: k must be in [1, digits]"));
     }
-    // x might not be in the range 0 < x < m, let's fix that:
-    while (u.x <= Z(0))
+    W x = static_cast<W>(inverse_mod_pow2(a));
+    if (k < static_cast<unsigned>(std::numeric_limits<W>::digits))
     {
-        u.x += modulus;
+        x &= static_cast<W>((W(1) << k) - 1u);
     }
-    // While indeed this is an inexpensive and comforting check,
-    // the multiplication overflows and hence makes the check itself buggy.
-    //BOOST_ASSERT(u.x*a % modulus == 1);
-    return u.x;
+    return static_cast<T>(x);
+}
+
+// For unbounded types the precision is doubled along with the number of correct bits, so the cost
+// is about that of two k-bit multiplications.
+template<class T>
+typename boost::enable_if_c< !std::numeric_limits< T >::is_bounded, T >::type
+inverse_mod_pow2(const T& a, unsigned k)
+{
+    if (k == 0)
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("inverse_mod_pow2: k must be > 0"));
+    }
+    T mask = (T(1) << k) - 1u;
+    T r = a & mask;
+    if (r < T(0))
+    {
+        r += mask + 1u;
+    }
+    if ((r & 1u) == 0u)
+    {
+        return T(0);
+    }
+    // Correct to 5 bits:
+    T x = T((T(r & 31u) * 3u) ^ 2u) & 31u;
+    for (unsigned bits = 5; bits < k;)
+    {
+        bits = 2 * bits < k ? 2 * bits : k;
+        T m = (T(1) << bits) - 1u;
+        // x(2 - rx), with 2 - rx taken modulo 2^bits to keep it positive:
+        T t = T(T(r & m) * x) & m;
+        x = T(x * T(m + 3u - t)) & m;
+    }
+    return T(x & mask);
 }
 
 }}
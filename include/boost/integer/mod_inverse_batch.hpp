@@ -0,0 +1,174 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_MOD_INVERSE_BATCH_HPP
+#define BOOST_INTEGER_MOD_INVERSE_BATCH_HPP
+#include <cstddef>
+#include <limits>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace boost { namespace integer {
+
+namespace euclidean_detail {
+
+// The number of inverses computed together; the lane loops below are written so that compilers
+// can vectorize them, and this is a multiple of any likely vector width.
+BOOST_STATIC_CONSTEXPR std::size_t batch_lanes = 64;
+
+//
+// Binary extended gcd on a block of batch_lanes lanes, each with an odd modulus b[i] and a value
+// o[i] < b[i]: leaves gcd(o[i], b[i]) in v[i] and x[i] with o[i]*x[i] = v[i] (mod b[i]).  The trip
+// count of the lane loops is a constant so that they are vectorized even at -O2.
+//
+// Every lane does the same operations for a fixed number of iterations, with the branches of the
+// scalar algorithm replaced by selects.  The invariants are u = o*x1 and v = o*x2 (mod b) with v odd;
+// each iteration halves u, after first subtracting v (swapping so that u >= v) when u is odd.
+// As log2(u*v) drops by at least one per iteration, u reaches zero after at most 2*32 + 1.
+//
+inline void batch_binary_gcd_cofactor(const boost::uint32_t* o, const boost::uint32_t* b, boost::uint32_t* v, boost::uint32_t* x)
+{
+    boost::uint32_t u[batch_lanes];
+    boost::uint32_t x1[batch_lanes];
+    boost::uint32_t half[batch_lanes];
+    for (std::size_t i = 0; i < batch_lanes; ++i)
+    {
+        u[i] = o[i];
+        v[i] = b[i];
+        x1[i] = b[i] == 1u ? 0u : 1u;
+        x[i] = 0;
+        half[i] = (b[i] >> 1) + 1u;  // 1/2 mod b
+    }
+    for (int iteration = 0; iteration < 65; ++iteration)
+    {
+        for (std::size_t i = 0; i < batch_lanes; ++i)
+        {
+            boost::uint32_t ui = u[i];
+            boost::uint32_t vi = v[i];
+            boost::uint32_t x1i = x1[i];
+            boost::uint32_t x2i = x[i];
+            boost::uint32_t odd = 0u - (ui & 1u);
+            boost::uint32_t swap = odd & (0u - static_cast<boost::uint32_t>(ui < vi));
+            // if (u odd) { if (u < v) swap(u, v), swap(x1, x2); u -= v; x1 -= x2 (mod b); }
+            boost::uint32_t t = (ui ^ vi) & swap;
+            ui ^= t;
+            vi ^= t;
+            t = (x1i ^ x2i) & swap;
+            x1i ^= t;
+            x2i ^= t;
+            ui -= vi & odd;
+            boost::uint32_t d = x2i & odd;
+            boost::uint32_t borrow = 0u - static_cast<boost::uint32_t>(x1i < d);
+            x1i = x1i - d + (b[i] & borrow);
+            // u /= 2; x1 /= 2 (mod b)
+            ui >>= 1;
+            x1i = (x1i >> 1) + (half[i] & (0u - (x1i & 1u)));
+            u[i] = ui;
+            v[i] = vi;
+            x1[i] = x1i;
+            x[i] = x2i;
+        }
+    }
+}
+
+template<class T>
+inline T reduce_mod(T a, T m, const boost::true_type&)
+{
+    T r = static_cast<T>(a % m);
+    return r < T(0) ? static_cast<T>(r + m) : r;
+}
+
+template<class T>
+inline T reduce_mod(T a, T m, const boost::false_type&)
+{
+    return static_cast<T>(a % m);
+}
+
+template<class T>
+void mod_inverse_block(const T* a, const T* m, T* out, bool* invertible, std::size_t lanes, std::size_t& failures)
+{
+    boost::uint32_t o[batch_lanes];
+    boost::uint32_t b[batch_lanes];
+    boost::uint32_t g[batch_lanes];
+    boost::uint32_t x[batch_lanes];
+    boost::uint32_t mod[batch_lanes];
+    bool even[batch_lanes];
+    bool usable[batch_lanes];
+    for (std::size_t i = 0; i < lanes; ++i)
+    {
+        // Reduce a into [0, m):
+        bool valid = m[i] >= T(2);
+        boost::uint32_t mi = valid ? static_cast<boost::uint32_t>(m[i]) : 1u;
+        boost::uint32_t av = valid ? static_cast<boost::uint32_t>(reduce_mod(a[i], m[i], boost::integral_constant<bool, std::numeric_limits<T>::is_signed>())) : 0u;
+        mod[i] = mi;
+        // The algorithm needs an odd modulus.  For even m an inverse needs odd a, and then
+        // m^-1 mod a gives a^-1 mod m.  Lanes which can have no inverse compute 0 mod 1 instead:
+        even[i] = (mi & 1u) == 0u;
+        usable[i] = valid && av != 0u && (!even[i] || (av & 1u) != 0u);
+        b[i] = !usable[i] ? 1u : even[i] ? av : mi;
+        o[i] = !usable[i] ? 0u : even[i] ? mi % av : av;
+    }
+    for (std::size_t i = lanes; i < batch_lanes; ++i)
+    {
+        b[i] = 1u;
+        o[i] = 0u;
+    }
+    batch_binary_gcd_cofactor(o, b, g, x);
+    for (std::size_t i = 0; i < lanes; ++i)
+    {
+        bool ok = usable[i] && g[i] == 1u;
+        boost::uint32_t result = x[i];
+        if (even[i] && ok)
+        {
+            // a*y = 1 (mod m) from m*x = 1 (mod a): m*x - 1 = k*a, so a*(-k) = 1 (mod m).
+            boost::uint32_t av = b[i];
+            if (av == 1u)
+            {
+                result = 1u;
+            }
+            else
+            {
+                boost::uint64_t k = (static_cast<boost::uint64_t>(mod[i]) * x[i] - 1u) / av;
+                result = static_cast<boost::uint32_t>(mod[i] - k);
+            }
+        }
+        if (!ok)
+        {
+            result = 0u;
+            ++failures;
+        }
+        out[i] = static_cast<T>(result);
+        if (invertible)
+        {
+            invertible[i] = ok;
+        }
+    }
+}
+
+} // namespace euclidean_detail
+
+//
+// Computes out[i] = mod_inverse(a[i], m[i]) for i in [0, n), for integer types of at most 32 bits.
+// Non-invertible elements, and those with m[i] < 2, give out[i] = 0 and invertible[i] = false
+// (when invertible is not null); the return value is the number of them.  out may alias a or m.
+//
+template<class T>
+std::size_t mod_inverse_batch(const T* a, const T* m, T* out, std::size_t n, bool* invertible = 0)
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<T>::is_integer && std::numeric_limits<T>::digits <= 32,
+        "mod_inverse_batch supports integer types of at most 32 bits.");
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i < n; i += euclidean_detail::batch_lanes)
+    {
+        std::size_t lanes = n - i < euclidean_detail::batch_lanes ? n - i : euclidean_detail::batch_lanes;
+        euclidean_detail::mod_inverse_block(a + i, m + i, out + i, invertible ? invertible + i : invertible, lanes, failures);
+    }
+    return failures;
+}
+
+}}
+#endif
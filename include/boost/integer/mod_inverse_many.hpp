@@ -0,0 +1,167 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_MOD_INVERSE_MANY_HPP
+#define BOOST_INTEGER_MOD_INVERSE_MANY_HPP
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+#include <execution>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#endif
+
+namespace boost { namespace integer {
+
+namespace euclidean_detail {
+
+// The number of elements sharing one inversion; it bounds the working storage, and is the unit of
+// work of the parallel form.
+BOOST_STATIC_CONSTEXPR std::size_t many_chunk_size = 4096;
+
+//
+// Montgomery's simultaneous inversion: given r[i] in [0, m), sets res[i] to the inverse of r[i]
+// modulo m, or zero where there is none, and returns the number of the latter.  The running products
+// r[0]*...*r[i] are formed in res, the last is inverted, and the inverses peeled off in reverse:
+// one mod_inverse and 3(n-1) multiplications in all.  Zeros are left out of the products; when the
+// product has no inverse some other element shares a factor with m, and the halves are done
+// separately until those elements are isolated.
+//
+template<class Z>
+std::size_t montgomery_invert(const Z* r, Z* res, std::size_t n, const Z& m)
+{
+    using boost::integer::modular_detail::mul_mod;
+    if (n == 0)
+    {
+        return 0;
+    }
+    Z product = Z(1);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (r[i] != Z(0))
+        {
+            product = i == 0 ? r[i] : mul_mod(product, r[i], m);
+        }
+        res[i] = product;
+    }
+    Z inverse = Z(0);
+    if (!boost::integer::mod_inverse(product, m, inverse))
+    {
+        if (n == 1)
+        {
+            res[0] = Z(0);
+            return 1;
+        }
+        std::size_t half = n / 2;
+        return montgomery_invert(r, res, half, m) + montgomery_invert(r + half, res + half, n - half, m);
+    }
+    std::size_t failures = 0;
+    for (std::size_t i = n; i-- > 0;)
+    {
+        if (r[i] == Z(0))
+        {
+            res[i] = Z(0);
+            ++failures;
+        }
+        else
+        {
+            // inverse is now 1/(r[0]*...*r[i]), and res[i - 1] is r[0]*...*r[i - 1]:
+            res[i] = i == 0 ? inverse : mul_mod(inverse, res[i - 1], m);
+            inverse = mul_mod(inverse, r[i], m);
+        }
+    }
+    return failures;
+}
+
+} // namespace euclidean_detail
+
+//
+// Writes the inverse modulo modulus of each element of [first, last) to out, or zero for elements
+// with no inverse, and returns the number of the latter.  Throws std::domain_error if modulus < 2.
+//
+template<class InputIt, class Z, class OutputIt>
+std::size_t mod_inverse_many(InputIt first, InputIt last, const Z& modulus, OutputIt out)
+{
+    if (modulus < Z(2))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse_many: modulus must be > 1"));
+    }
+    std::vector<Z> values;
+    std::vector<Z> inverses;
+    values.reserve(euclidean_detail::many_chunk_size);
+    std::size_t failures = 0;
+    while (first != last)
+    {
+        values.clear();
+        for (; first != last && values.size() < euclidean_detail::many_chunk_size; ++first)
+        {
+            values.push_back(boost::integer::modular_detail::reduce_residue(Z(*first), modulus));
+        }
+        inverses.resize(values.size());
+        failures += euclidean_detail::montgomery_invert(values.data(), inverses.data(), values.size(), modulus);
+        for (std::size_t i = 0; i < inverses.size(); ++i, ++out)
+        {
+            *out = inverses[i];
+        }
+    }
+    return failures;
+}
+
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+//
+// As above, with chunks of chunk_size elements inverted independently under the execution policy.
+// Each chunk costs one mod_inverse, so chunks should be large enough for that to be amortized.
+//
+template<class ExecutionPolicy, class RandomIt, class Z, class RandomOut>
+typename std::enable_if<std::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, std::size_t>::type
+mod_inverse_many(ExecutionPolicy&& policy, RandomIt first, RandomIt last, const Z& modulus, RandomOut out,
+                 std::size_t chunk_size = euclidean_detail::many_chunk_size)
+{
+    if (modulus < Z(2))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse_many: modulus must be > 1"));
+    }
+    if (chunk_size == 0)
+    {
+        chunk_size = euclidean_detail::many_chunk_size;
+    }
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::size_t> chunks((n + chunk_size - 1) / chunk_size);
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        chunks[i] = i * chunk_size;
+    }
+    return std::transform_reduce(std::forward<ExecutionPolicy>(policy), chunks.begin(), chunks.end(), std::size_t(0), std::plus<std::size_t>(),
+        [=](std::size_t begin)
+        {
+            std::size_t size = n - begin < chunk_size ? n - begin : chunk_size;
+            std::vector<Z> values(size);
+            std::vector<Z> inverses(size);
+            RandomIt in = first + begin;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values[i] = boost::integer::modular_detail::reduce_residue(Z(in[i]), modulus);
+            }
+            std::size_t failures = euclidean_detail::montgomery_invert(values.data(), inverses.data(), size, modulus);
+            RandomOut o = out + begin;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                o[i] = inverses[i];
+            }
+            return failures;
+        });
+}
+#endif
+
+}}
+#endif
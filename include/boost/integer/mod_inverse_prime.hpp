@@ -0,0 +1,187 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_MOD_INVERSE_PRIME_HPP
+#define BOOST_INTEGER_MOD_INVERSE_PRIME_HPP
+#include <cstddef>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/core/enable_if.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+// The number of inverses computed together by the array form; as every element follows the same
+// sequence of multiplications, the lane loops below can be vectorized.
+BOOST_STATIC_CONSTEXPR std::size_t prime_lanes = 64;
+
+// Both take a in (0, p), and p odd.
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< montgomery_method< Z >::value, Z >::type
+fermat_inverse(const Z& a, const Z& p) BOOST_NOEXCEPT
+{
+    typedef typename montgomery_method< Z >::word_type U;
+    montgomery_word< U > mont(static_cast<U>(p));
+    U x = window_pow(mont, mont.to_montgomery(static_cast<U>(a)), static_cast<U>(p - 2));
+    return static_cast<Z>(mont.from_montgomery(x));
+}
+
+template<class Z>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< !montgomery_method< Z >::value, Z >::type
+fermat_inverse(const Z& a, const Z& p)
+{
+    return window_pow(plain_multiplier< Z >(p), a, Z(p - 2));
+}
+
+//
+// a^(p-2) for a block of prime_lanes values x in Montgomery form, with the fixed window of
+// window_pow: the digits of the exponent are the same for every lane, so each step is a loop of
+// independent multiplications with a constant trip count.
+//
+template<class U>
+void fermat_inverse_block(const montgomery_word< U >& m, U* x)
+{
+    const montgomery_word< U > mont = m;
+    U table[16][prime_lanes];
+    for (std::size_t i = 0; i < prime_lanes; ++i)
+    {
+        table[0][i] = mont.one;
+        table[1][i] = x[i];
+    }
+    for (int d = 2; d < 16; ++d)
+    {
+        for (std::size_t i = 0; i < prime_lanes; ++i)
+        {
+            table[d][i] = mont.mul(table[d - 1][i], x[i]);
+        }
+    }
+    const U e = static_cast<U>(mont.modulus - 2u);
+    int shift = leading_digit_shift(e);
+    unsigned digit = static_cast<unsigned>((e >> shift) & 15u);
+    for (std::size_t i = 0; i < prime_lanes; ++i)
+    {
+        x[i] = table[digit][i];
+    }
+    for (shift -= 4; shift >= 0; shift -= 4)
+    {
+        for (int s = 0; s < 4; ++s)
+        {
+            for (std::size_t i = 0; i < prime_lanes; ++i)
+            {
+                x[i] = mont.mul(x[i], x[i]);
+            }
+        }
+        digit = static_cast<unsigned>((e >> shift) & 15u);
+        if (digit != 0)
+        {
+            for (std::size_t i = 0; i < prime_lanes; ++i)
+            {
+                x[i] = mont.mul(x[i], table[digit][i]);
+            }
+        }
+    }
+}
+
+template<class Z>
+typename boost::enable_if_c< montgomery_method< Z >::value, std::size_t >::type
+fermat_inverse_array(const Z* a, Z* out, std::size_t n, const Z& p)
+{
+    typedef typename montgomery_method< Z >::word_type U;
+    const montgomery_word< U > mont(static_cast<U>(p));
+    U x[prime_lanes];
+    std::size_t failures = 0;
+    for (std::size_t start = 0; start < n; start += prime_lanes)
+    {
+        std::size_t lanes = n - start < prime_lanes ? n - start : prime_lanes;
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            x[i] = mont.to_montgomery(static_cast<U>(reduce_residue(a[start + i], p)));
+        }
+        for (std::size_t i = lanes; i < prime_lanes; ++i)
+        {
+            x[i] = mont.one;
+        }
+        fermat_inverse_block(mont, x);
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            // Zero stays zero:
+            U result = mont.from_montgomery(x[i]);
+            failures += result == 0u;
+            out[start + i] = static_cast<Z>(result);
+        }
+    }
+    return failures;
+}
+
+template<class Z>
+typename boost::enable_if_c< !montgomery_method< Z >::value, std::size_t >::type
+fermat_inverse_array(const Z* a, Z* out, std::size_t n, const Z& p)
+{
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Z r = reduce_residue(a[i], p);
+        out[i] = r == Z(0) ? r : fermat_inverse(r, p);
+        failures += out[i] == Z(0);
+    }
+    return failures;
+}
+
+} // namespace modular_detail
+
+//
+// 1/a mod p for a prime p, as a^(p-2) mod p: zero if p divides a.  Unlike mod_inverse this is a
+// fixed sequence of Montgomery multiplications for a given p, which pipelines well, but the result
+// is meaningless if p is not prime.  Throws std::domain_error if p < 2.
+//
+template<class Z>
+BOOST_CXX14_CONSTEXPR Z mod_inverse_prime(Z a, Z p)
+{
+    if (p < Z(2))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse_prime: modulus must be > 1"));
+    }
+    a = modular_detail::reduce_residue(a, p);
+    if (a == Z(0) || a == Z(1))
+    {
+        return a;
+    }
+    if ((p & 1u) == 0u)
+    {
+        // p = 2 is done above, other even p are not prime, and Montgomery form needs p odd:
+        return modular_detail::window_pow(modular_detail::plain_multiplier< Z >(p), a, Z(p - 2));
+    }
+    return modular_detail::fermat_inverse(a, p);
+}
+
+//
+// out[i] = mod_inverse_prime(a[i], p) for i in [0, n), returning the number of zero results.
+// out may alias a.  Throws std::domain_error if p < 2.
+//
+template<class Z>
+std::size_t mod_inverse_prime(const Z* a, Z* out, std::size_t n, Z p)
+{
+    if (p < Z(2))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse_prime: modulus must be > 1"));
+    }
+    if ((p & 1u) == 0u)
+    {
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = mod_inverse_prime(a[i], p);
+            failures += out[i] == Z(0);
+        }
+        return failures;
+    }
+    return modular_detail::fermat_inverse_array(a, out, n, p);
+}
+
+}}
+#endif
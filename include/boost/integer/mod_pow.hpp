@@ -0,0 +1,501 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_MOD_POW_HPP
+#define BOOST_INTEGER_MOD_POW_HPP
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/core/enable_if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/integer/barrett.hpp>
+#include <boost/integer/montgomery.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+//
+// Sliding window exponentiation (Menezes, van Oorschot and Vanstone, algorithm 14.85): e is read
+// from the top in windows of at most k bits which start and end with a set bit, separated by runs
+// of zeros.  Each window costs a squaring per bit and one multiplication by an odd power of x from a
+// table of 2^(k-1), half the table of a fixed window of the same width, and the zero runs cost only
+// squarings.
+//
+BOOST_STATIC_CONSTEXPR int sliding_table_size = 32;
+
+// The window width for an exponent of the given number of bits, as in OpenSSL:
+BOOST_CXX14_CONSTEXPR inline int sliding_window_bits(int bits) BOOST_NOEXCEPT
+{
+    return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
+}
+
+// The number of significant bits of e > 0, by doubling and then halving the shift which clears it:
+template<class E>
+BOOST_CXX14_CONSTEXPR int exponent_bits(const E& e)
+{
+    const int limit = std::numeric_limits<E>::is_bounded ? std::numeric_limits<E>::digits : INT_MAX;
+    int low = 0;
+    int high = 1;
+    while (high < limit && E(e >> high) != E(0))
+    {
+        low = high;
+        high = high > limit / 2 ? limit : 2 * high;
+    }
+    // e >> low is not zero and e >> high is:
+    while (high - low > 1)
+    {
+        const int middle = low + (high - low) / 2;
+        if (E(e >> middle) != E(0))
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return high;
+}
+
+// The window whose top bit is bit i of e, which is set: bits i down to the lowest set bit low at or
+// above i - k + 1.  Returns its value, which is odd.
+template<class E>
+BOOST_CXX14_CONSTEXPR unsigned sliding_window(const E& e, int i, int k, int& low)
+{
+    low = i - k + 1 < 0 ? 0 : i - k + 1;
+    unsigned digit = static_cast<unsigned>(E(E(e >> low) & E((1u << (i - low + 1)) - 1u)));
+    while ((digit & 1u) == 0u)
+    {
+        digit >>= 1;
+        ++low;
+    }
+    return digit;
+}
+
+//
+// Recodes e > 0 of the given number of bits with windows of at most k bits: calls
+// visitor.window(squarings, index) for each window from the top, where the result is squared that
+// many times and then multiplied by x^(2*index + 1) (the first window sets the result, and has no
+// squarings), and then visitor.finish(squarings) for the zeros below the last window.
+//
+template<class E, class Visitor>
+BOOST_CXX14_CONSTEXPR void sliding_recode(const E& e, int bits, int k, Visitor& visitor)
+{
+    int squarings = 0;
+    int low = 0;
+    for (int i = bits - 1; i >= 0;)
+    {
+        if ((E(e >> i) & 1u) == 0u)
+        {
+            ++squarings;
+            --i;
+        }
+        else
+        {
+            const unsigned digit = sliding_window(e, i, k, low);
+            squarings += i - low + 1;
+            visitor.window(i == bits - 1 ? 0 : squarings, digit >> 1);
+            squarings = 0;
+            i = low - 1;
+        }
+    }
+    visitor.finish(squarings);
+}
+
+// Fills table[j] = x^(2j + 1) for j < 2^(k-1), for any number of lanes:
+template<class Multiplier, class Z>
+BOOST_CXX14_CONSTEXPR void sliding_table(const Multiplier& mult, const Z& x, int k, Z* table)
+{
+    table[0] = x;
+    if (k > 1)
+    {
+        const Z square = mult.mul(x, x);
+        for (int j = 1; j < (1 << (k - 1)); ++j)
+        {
+            table[j] = mult.mul(table[j - 1], square);
+        }
+    }
+}
+
+template<class Multiplier, class Z>
+struct sliding_pow_visitor
+{
+    const Multiplier& mult;
+    const Z* table;
+    Z result;
+
+    BOOST_CXX14_CONSTEXPR void window(int squarings, unsigned index)
+    {
+        if (squarings == 0)
+        {
+            result = table[index];
+            return;
+        }
+        finish(squarings);
+        result = mult.mul(result, table[index]);
+    }
+    BOOST_CXX14_CONSTEXPR void finish(int squarings)
+    {
+        for (int s = 0; s < squarings; ++s)
+        {
+            result = mult.mul(result, result);
+        }
+    }
+};
+
+// x^e for any e >= 0, in the multiplier's representation:
+template<class Multiplier, class Z, class E>
+BOOST_CXX14_CONSTEXPR Z sliding_pow(const Multiplier& mult, const Z& x, const E& e)
+{
+    if (e == E(0))
+    {
+        return mult.one;
+    }
+    const int bits = exponent_bits(e);
+    const int k = sliding_window_bits(bits);
+    Z table[sliding_table_size] = {};
+    sliding_table(mult, x, k, table);
+    sliding_pow_visitor< Multiplier, Z > visitor = { mult, table, x };
+    sliding_recode(e, bits, k, visitor);
+    return visitor.result;
+}
+
+//
+// The recoding of one exponent, kept to be applied to many bases.
+//
+struct pow_window
+{
+    int squarings;
+    unsigned index;
+};
+
+struct pow_schedule
+{
+    int width;
+    std::vector<pow_window> windows;
+    int tail;
+
+    // e > 0:
+    template<class E>
+    explicit pow_schedule(const E& e) : width(0), windows(), tail(0)
+    {
+        const int bits = exponent_bits(e);
+        width = sliding_window_bits(bits);
+        sliding_recode(e, bits, width, *this);
+    }
+
+    void window(int squarings, unsigned index)
+    {
+        const pow_window w = { squarings, index };
+        windows.push_back(w);
+    }
+    void finish(int squarings)
+    {
+        tail = squarings;
+    }
+};
+
+// The number of bases the array form raises together where they are single words: every lane
+// follows the same schedule, so the lane loops have a constant trip count and can be vectorized.
+BOOST_STATIC_CONSTEXPR std::size_t pow_lanes = 64;
+
+template<std::size_t Lanes, class Multiplier, class V>
+void schedule_pow_block(const Multiplier& m, const pow_schedule& schedule, V* x)
+{
+    const Multiplier mult = m;
+    V table[sliding_table_size][Lanes];
+    for (std::size_t i = 0; i < Lanes; ++i)
+    {
+        table[0][i] = x[i];
+    }
+    if (schedule.width > 1)
+    {
+        V square[Lanes];
+        for (std::size_t i = 0; i < Lanes; ++i)
+        {
+            square[i] = mult.mul(x[i], x[i]);
+        }
+        for (int j = 1; j < (1 << (schedule.width - 1)); ++j)
+        {
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                table[j][i] = mult.mul(table[j - 1][i], square[i]);
+            }
+        }
+    }
+    for (std::size_t w = 0; w < schedule.windows.size(); ++w)
+    {
+        const pow_window& step = schedule.windows[w];
+        if (w == 0)
+        {
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                x[i] = table[step.index][i];
+            }
+            continue;
+        }
+        for (int s = 0; s < step.squarings; ++s)
+        {
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                x[i] = mult.mul(x[i], x[i]);
+            }
+        }
+        for (std::size_t i = 0; i < Lanes; ++i)
+        {
+            x[i] = mult.mul(x[i], table[step.index][i]);
+        }
+    }
+    for (int s = 0; s < schedule.tail; ++s)
+    {
+        for (std::size_t i = 0; i < Lanes; ++i)
+        {
+            x[i] = mult.mul(x[i], x[i]);
+        }
+    }
+}
+
+//
+// The multipliers mod_pow uses, with the conversion of values in [0, m) of T to and from their
+// representation: Montgomery's for odd m > 1 and Barrett's for even m, for unsigned fixed width T,
+// and mul_mod on the values themselves for other types.
+//
+template<class T>
+struct pow_montgomery
+{
+    typedef T type;
+    typedef montgomery_engine< T > engine;
+    typedef typename engine::value_type value_type;
+    BOOST_STATIC_CONSTEXPR std::size_t lanes = montgomery_method< T >::value ? pow_lanes : 1;
+
+    typename engine::type mult;
+
+    BOOST_CXX14_CONSTEXPR explicit pow_montgomery(const T& m) : mult(engine::make(m)) {}
+
+    BOOST_CXX14_CONSTEXPR value_type load(const T& a) const
+    {
+        return mult.to_montgomery(engine::load(a));
+    }
+    BOOST_CXX14_CONSTEXPR T store(const value_type& x) const
+    {
+        return engine::store(mult.from_montgomery(x));
+    }
+};
+
+template<class T>
+struct pow_barrett
+{
+    typedef T type;
+    typedef barrett_engine< T > engine;
+    typedef typename engine::value_type value_type;
+    BOOST_STATIC_CONSTEXPR std::size_t lanes = montgomery_method< T >::value ? pow_lanes : 1;
+
+    typename engine::type mult;
+
+    BOOST_CXX14_CONSTEXPR explicit pow_barrett(const T& m) : mult(engine::load(m)) {}
+
+    BOOST_CXX14_CONSTEXPR value_type load(const T& a) const
+    {
+        return engine::load(a);
+    }
+    BOOST_CXX14_CONSTEXPR T store(const value_type& x) const
+    {
+        return engine::store(x);
+    }
+};
+
+template<class Z>
+struct pow_plain
+{
+    typedef Z type;
+    typedef Z value_type;
+    BOOST_STATIC_CONSTEXPR std::size_t lanes = 1;
+
+    plain_multiplier< Z > mult;
+
+    BOOST_CXX14_CONSTEXPR explicit pow_plain(const Z& m) : mult(m) {}
+
+    BOOST_CXX14_CONSTEXPR const Z& load(const Z& a) const
+    {
+        return a;
+    }
+    BOOST_CXX14_CONSTEXPR const Z& store(const Z& x) const
+    {
+        return x;
+    }
+};
+
+// The unsigned type mod_pow works in for Z, where it has one: Z itself for fixed width unsigned
+// types, and the unsigned type of the same width for builtin signed ones, which holds [0, m).
+template<class Z, bool builtin = boost::is_integral<Z>::value>
+struct pow_word
+{
+    static const bool value = std::numeric_limits<Z>::is_bounded && !std::numeric_limits<Z>::is_signed;
+    typedef Z type;
+};
+
+template<class Z>
+struct pow_word<Z, true>
+{
+    static const bool value = true;
+    typedef typename boost::make_unsigned<Z>::type type;
+};
+
+template<class Pow, class E>
+BOOST_CXX14_CONSTEXPR typename Pow::type run_pow(const Pow& p, const typename Pow::type& a, const E& e)
+{
+    return p.store(sliding_pow(p.mult, p.load(a), e));
+}
+
+// a in [0, m), m > 1:
+template<class Z, class E>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< pow_word< Z >::value, Z >::type
+pow_imp(const Z& a, const E& e, const Z& m)
+{
+    typedef typename pow_word< Z >::type U;
+    const U p = static_cast<U>(m);
+    if ((p & 1u) != 0u)
+    {
+        return static_cast<Z>(run_pow(pow_montgomery< U >(p), static_cast<U>(a), e));
+    }
+    if (mul_mod_method< U >::by_uint64)
+    {
+        // A single Barrett reduction of 32 bits is slower than a 64-bit division:
+        return static_cast<Z>(run_pow(pow_plain< U >(p), static_cast<U>(a), e));
+    }
+    return static_cast<Z>(run_pow(pow_barrett< U >(p), static_cast<U>(a), e));
+}
+
+template<class Z, class E>
+BOOST_CXX14_CONSTEXPR typename boost::enable_if_c< !pow_word< Z >::value, Z >::type
+pow_imp(const Z& a, const E& e, const Z& m)
+{
+    return run_pow(pow_plain< Z >(m), a, e);
+}
+
+template<class Pow, class Z>
+void pow_array(const Pow& p, const pow_schedule& schedule, const Z* base, Z* out, std::size_t n, const Z& m)
+{
+    typedef typename Pow::type U;
+    typedef typename Pow::value_type V;
+    V x[Pow::lanes];
+    for (std::size_t start = 0; start < n; start += Pow::lanes)
+    {
+        const std::size_t lanes = n - start < Pow::lanes ? n - start : Pow::lanes;
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            x[i] = p.load(static_cast<U>(reduce_residue(base[start + i], m)));
+        }
+        for (std::size_t i = lanes; i < Pow::lanes; ++i)
+        {
+            x[i] = p.mult.one;
+        }
+        schedule_pow_block< Pow::lanes >(p.mult, schedule, x);
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            out[start + i] = static_cast<Z>(p.store(x[i]));
+        }
+    }
+}
+
+// m > 1:
+template<class Z>
+typename boost::enable_if_c< pow_word< Z >::value >::type
+pow_array_imp(const pow_schedule& schedule, const Z* base, Z* out, std::size_t n, const Z& m)
+{
+    typedef typename pow_word< Z >::type U;
+    const U p = static_cast<U>(m);
+    if ((p & 1u) != 0u)
+    {
+        pow_array(pow_montgomery< U >(p), schedule, base, out, n, m);
+    }
+    else
+    {
+        pow_array(pow_barrett< U >(p), schedule, base, out, n, m);
+    }
+}
+
+template<class Z>
+typename boost::enable_if_c< !pow_word< Z >::value >::type
+pow_array_imp(const pow_schedule& schedule, const Z* base, Z* out, std::size_t n, const Z& m)
+{
+    pow_array(pow_plain< Z >(m), schedule, base, out, n, m);
+}
+
+template<class E>
+BOOST_CXX14_CONSTEXPR bool exponent_negative(const E& e, const boost::true_type&)
+{
+    return e < E(0);
+}
+
+template<class E>
+BOOST_CXX14_CONSTEXPR bool exponent_negative(const E&, const boost::false_type&)
+{
+    return false;
+}
+
+template<class Z, class E>
+BOOST_CXX14_CONSTEXPR void check_pow_arguments(const E& e, const Z& m)
+{
+    if (m < Z(1))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_pow: modulus must be > 0"));
+    }
+    if (exponent_negative(e, boost::integral_constant<bool, std::numeric_limits<E>::is_signed>()))
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_pow: exponent must be >= 0"));
+    }
+}
+
+} // namespace modular_detail
+
+//
+// base^exp mod m, in [0, m), for any base, exp >= 0 of any integer type, and m > 0; 0^0 is 1 mod m.
+// Throws std::domain_error if m or exp is out of range.  The exponent is recoded in sliding windows;
+// the multiplications are Montgomery's for odd m and Barrett's for even m when Z is a builtin type or
+// a fixed width unsigned multiprecision type, and mul_mod otherwise.
+//
+template<class Z, class E>
+BOOST_CXX14_CONSTEXPR Z mod_pow(const Z& base, const E& exp, const Z& m)
+{
+    modular_detail::check_pow_arguments(exp, m);
+    if (m == Z(1))
+    {
+        return Z(0);
+    }
+    return modular_detail::pow_imp(modular_detail::reduce_residue(base, m), exp, m);
+}
+
+//
+// out[i] = mod_pow(base[i], exp, m) for i in [0, n); out may alias base.  The exponent is recoded
+// and the constants of the modulus computed once for all the bases.  Throws std::domain_error if m
+// or exp is out of range.
+//
+template<class Z, class E>
+void mod_pow(const Z* base, Z* out, std::size_t n, const E& exp, const Z& m)
+{
+    modular_detail::check_pow_arguments(exp, m);
+    if (m == Z(1) || exp == E(0))
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = m == Z(1) ? Z(0) : Z(1);
+        }
+        return;
+    }
+    const modular_detail::pow_schedule schedule(exp);
+    modular_detail::pow_array_imp(schedule, base, out, n, m);
+}
+
+}}
+#endif
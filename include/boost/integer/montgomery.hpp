@@ -0,0 +1,273 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_MONTGOMERY_HPP
+#define BOOST_INTEGER_MONTGOMERY_HPP
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+//
+// Montgomery multiplication of values of N limbs of type U, R = 2^(N*bits), with the multiplication
+// and the reduction interleaved a limb at a time (the CIOS method of Koc, Acar and Kaliski).  Each
+// step adds q*p, q = -t/p mod 2^bits, to clear the low limb of the running sum t, which stays below
+// 2p; one conditional subtraction at the end leaves the product in [0, p).  This is for the types
+// with no integer type of twice their width, which montgomery_word needs.
+//
+template<class U, std::size_t N>
+struct montgomery_limbs
+{
+    typedef typename montgomery_wide< U >::type wide_type;
+    BOOST_STATIC_CONSTEXPR int bits = static_cast<int>(sizeof(U) * CHAR_BIT);
+
+    typedef limb_array< U, N > value_type;
+
+    value_type modulus;
+    U neg_inverse;          // -1/p mod 2^bits
+    value_type one;         // R mod p
+    value_type r_squared;   // R^2 mod p
+
+    // p odd, and r = R mod p:
+    BOOST_CXX14_CONSTEXPR montgomery_limbs(const value_type& p, const value_type& r) BOOST_NOEXCEPT
+        : modulus(p),
+          neg_inverse(static_cast<U>(U(0) - boost::integer::inverse_mod_pow2(p.limbs[0]))),
+          one(r),
+          r_squared()
+    {
+        // R^2 mod p is R in Montgomery form, 2^(N*bits) from 2 in Montgomery form, 2R mod p:
+        U t[N + 1] = {};
+        U carry = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            t[i] = static_cast<U>((one.limbs[i] << 1) | carry);
+            carry = static_cast<U>(one.limbs[i] >> (bits - 1));
+        }
+        t[N] = carry;
+        value_type two = {};
+        reduce_once(t, two);
+        r_squared = window_pow(*this, two, static_cast<unsigned>(N) * bits);
+    }
+
+    // t in [0, 2p) of N + 1 limbs, less p if it is not below p:
+    BOOST_CXX14_CONSTEXPR void reduce_once(const U* t, value_type& result) const BOOST_NOEXCEPT
+    {
+        value_type difference = {};
+        U borrow = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            wide_type d = static_cast<wide_type>(static_cast<wide_type>(t[i]) - modulus.limbs[i] - borrow);
+            difference.limbs[i] = static_cast<U>(d);
+            borrow = static_cast<U>(d >> bits) != 0u ? 1u : 0u;
+        }
+        const bool less = t[N] == 0u && borrow != 0u;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.limbs[i] = less ? t[i] : difference.limbs[i];
+        }
+    }
+
+    BOOST_CXX14_CONSTEXPR value_type mul(const value_type& a, const value_type& b) const BOOST_NOEXCEPT
+    {
+        U t[N + 2] = {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            // t += a * b[i]:
+            wide_type s = 0;
+            U carry = 0;
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                s = static_cast<wide_type>(a.limbs[j]) * b.limbs[i] + t[j] + carry;
+                t[j] = static_cast<U>(s);
+                carry = static_cast<U>(s >> bits);
+            }
+            s = static_cast<wide_type>(t[N]) + carry;
+            t[N] = static_cast<U>(s);
+            t[N + 1] = static_cast<U>(s >> bits);
+            // t = (t + q * p) / 2^bits:
+            const U q = static_cast<U>(t[0] * neg_inverse);
+            s = static_cast<wide_type>(q) * modulus.limbs[0] + t[0];
+            carry = static_cast<U>(s >> bits);
+            for (std::size_t j = 1; j < N; ++j)
+            {
+                s = static_cast<wide_type>(q) * modulus.limbs[j] + t[j] + carry;
+                t[j - 1] = static_cast<U>(s);
+                carry = static_cast<U>(s >> bits);
+            }
+            s = static_cast<wide_type>(t[N]) + carry;
+            t[N - 1] = static_cast<U>(s);
+            t[N] = static_cast<U>(t[N + 1] + static_cast<U>(s >> bits));
+        }
+        value_type result = {};
+        reduce_once(t, result);
+        return result;
+    }
+
+    // a in [0, p) to and from Montgomery form:
+    BOOST_CXX14_CONSTEXPR value_type to_montgomery(const value_type& a) const BOOST_NOEXCEPT
+    {
+        return mul(a, r_squared);
+    }
+    BOOST_CXX14_CONSTEXPR value_type from_montgomery(const value_type& a) const BOOST_NOEXCEPT
+    {
+        value_type unit = {};
+        unit.limbs[0] = 1u;
+        return mul(a, unit);
+    }
+};
+
+//
+// The multiplier used for T, and the conversion of values of T to and from its representation:
+// montgomery_word for builtin types of up to 64 bits (32 without a 128-bit integer type), and
+// montgomery_limbs otherwise.
+//
+template<class T, bool word = montgomery_method< T >::value>
+struct montgomery_engine
+{
+    typedef typename montgomery_method< T >::word_type value_type;
+    typedef montgomery_word< value_type > type;
+
+    static BOOST_CXX14_CONSTEXPR type make(const T& p)
+    {
+        return type(static_cast<value_type>(p));
+    }
+    static BOOST_CXX14_CONSTEXPR value_type load(const T& a)
+    {
+        return static_cast<value_type>(a);
+    }
+    static BOOST_CXX14_CONSTEXPR T store(const value_type& a)
+    {
+        return static_cast<T>(a);
+    }
+};
+
+template<class T>
+struct montgomery_engine<T, false>
+{
+    typedef limb_conversion< T > conversion;
+    typedef montgomery_limbs< typename conversion::limb_type, conversion::count > type;
+    typedef typename conversion::value_type value_type;
+
+    static BOOST_CXX14_CONSTEXPR type make(const T& p)
+    {
+        // 2^digits mod p, without overflow, then doubled up to R mod p:
+        T r = T(T(T((std::numeric_limits<T>::max)() - p) + 1u) % p);
+        for (int i = std::numeric_limits<T>::digits; i < static_cast<int>(conversion::count) * conversion::bits; ++i)
+        {
+            r = add_mod(r, r, p);
+        }
+        return type(load(p), load(r));
+    }
+    static BOOST_CXX14_CONSTEXPR value_type load(const T& a)
+    {
+        return conversion::load(a);
+    }
+    static BOOST_CXX14_CONSTEXPR T store(const value_type& x)
+    {
+        return conversion::store(x);
+    }
+};
+
+} // namespace modular_detail
+
+//
+// Arithmetic modulo a fixed odd modulus p > 1 in Montgomery form, where a is held as aR mod p for a
+// power of two R > p and products are reduced without division.  T is an unsigned builtin type or a
+// fixed width unsigned multiprecision type; to_montgomery takes any value of T, and the remaining
+// members take and return values in Montgomery form, which lie in [0, p).
+//
+template<class T>
+class montgomery_context
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<T>::is_integer && std::numeric_limits<T>::is_bounded && !std::numeric_limits<T>::is_signed,
+        "montgomery_context supports unsigned fixed width types only.");
+
+    typedef modular_detail::montgomery_engine< T > engine;
+    typedef typename engine::type multiplier_type;
+    typedef typename engine::value_type value_type;
+
+    static BOOST_CXX14_CONSTEXPR const T& checked_modulus(const T& p)
+    {
+        if (p < T(3) || (p & 1u) == 0u)
+        {
+            BOOST_THROW_EXCEPTION(std::domain_error("montgomery_context: modulus must be odd and > 1"));
+        }
+        return p;
+    }
+
+    T modulus_;
+    multiplier_type mont_;
+    value_type r_cubed_;   // R^3 mod p
+
+public:
+    // Throws std::domain_error unless modulus is odd and greater than one.
+    BOOST_CXX14_CONSTEXPR explicit montgomery_context(const T& modulus)
+        : modulus_(checked_modulus(modulus)),
+          mont_(engine::make(modulus)),
+          r_cubed_(mont_.mul(mont_.r_squared, mont_.r_squared))
+    {}
+
+    BOOST_CXX14_CONSTEXPR const T& modulus() const BOOST_NOEXCEPT
+    {
+        return modulus_;
+    }
+
+    // 1 in Montgomery form, R mod p:
+    BOOST_CXX14_CONSTEXPR T one() const
+    {
+        return engine::store(mont_.one);
+    }
+
+    // aR mod p, for any a:
+    BOOST_CXX14_CONSTEXPR T to_montgomery(const T& a) const
+    {
+        return engine::store(mont_.to_montgomery(engine::load(a < modulus_ ? a : T(a % modulus_))));
+    }
+
+    // The value x represents, x/R mod p:
+    BOOST_CXX14_CONSTEXPR T from_montgomery(const T& x) const
+    {
+        return engine::store(mont_.from_montgomery(engine::load(x)));
+    }
+
+    // xy/R mod p, which represents the product of the values x and y represent:
+    BOOST_CXX14_CONSTEXPR T mul(const T& x, const T& y) const
+    {
+        return engine::store(mont_.mul(engine::load(x), engine::load(y)));
+    }
+
+    BOOST_CXX14_CONSTEXPR T sqr(const T& x) const
+    {
+        const value_type v = engine::load(x);
+        return engine::store(mont_.mul(v, v));
+    }
+
+    // x raised to the power e >= 0, by a fixed 4-bit window; x^0 is one().
+    template<class E>
+    BOOST_CXX14_CONSTEXPR T pow(const T& x, const E& e) const
+    {
+        return engine::store(modular_detail::window_pow(mont_, engine::load(x), e));
+    }
+
+    // The inverse of x, or zero if there is none: 1/x is 1/(aR) = (1/a)/R mod p, and Montgomery
+    // multiplication by R^3 turns that into (1/a)R.
+    BOOST_CXX14_CONSTEXPR T inverse(const T& x) const
+    {
+        return engine::store(mont_.mul(engine::load(boost::integer::mod_inverse(x, modulus_)), r_cubed_));
+    }
+};
+
+}}
+#endif
@@ -0,0 +1,471 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_SAFEGCD_HPP
+#define BOOST_INTEGER_SAFEGCD_HPP
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/integer/mod_inverse.hpp>
+
+//
+// Constant time gcd and modular inverse by Bernstein and Yang's divsteps, "Fast constant-time gcd
+// computation and modular inversion", TCHES 2019, with the limb arithmetic of libsecp256k1's
+// safegcd implementation.
+//
+namespace boost { namespace integer {
+
+namespace safegcd_detail {
+
+// Values are held in signed limbs of limb_bits bits, all but the most significant in [0, 2^limb_bits),
+// and divsteps are done limb_bits at a time on the low limbs, giving a transition matrix whose
+// entries fit a limb; applying it to a limb needs a product of twice the width.
+#ifdef BOOST_HAS_INT128
+struct limb_traits
+{
+    typedef boost::int64_t limb;
+    typedef boost::uint64_t ulimb;
+    typedef boost::int128_type wide;
+    BOOST_STATIC_CONSTEXPR int bits = 62;
+};
+#else
+struct limb_traits
+{
+    typedef boost::int32_t limb;
+    typedef boost::uint32_t ulimb;
+    typedef boost::int64_t wide;
+    BOOST_STATIC_CONSTEXPR int bits = 30;
+};
+#endif
+
+// The 30-bit form, for testing where the 62-bit one is the default:
+struct limb_traits_30
+{
+    typedef boost::int32_t limb;
+    typedef boost::uint32_t ulimb;
+    typedef boost::int64_t wide;
+    BOOST_STATIC_CONSTEXPR int bits = 30;
+};
+
+//
+// Sizes for operands of up to digits bits: N limbs hold anything of magnitude below 2^(digits + 1),
+// and by Bernstein and Yang's Theorem 11.2 g is zero after divsteps steps starting from odd f and
+// any g with f^2 + 4g^2 <= 5 * 2^(2 digits), so certainly for f, g < 2^digits.
+//
+template<class Traits, int digits>
+struct safegcd_size
+{
+    BOOST_STATIC_CONSTEXPR std::size_t limbs = digits / Traits::bits + 1;
+    BOOST_STATIC_CONSTEXPR int divsteps = digits < 46 ? (49 * digits + 80) / 17 : (49 * digits + 57) / 17;
+    BOOST_STATIC_CONSTEXPR int batches = (divsteps + Traits::bits - 1) / Traits::bits;
+};
+
+//
+// Every function here does the same operations and memory accesses whatever the values of its
+// limbs: conditions on them are turned into masks of all ones or all zeros.
+//
+template<class Traits, std::size_t N>
+struct safegcd
+{
+    typedef typename Traits::limb limb;
+    typedef typename Traits::ulimb ulimb;
+    typedef typename Traits::wide wide;
+    BOOST_STATIC_CONSTEXPR int bits = Traits::bits;
+    BOOST_STATIC_CONSTEXPR int sign_shift = static_cast<int>(sizeof(limb) * CHAR_BIT) - 1;
+    BOOST_STATIC_CONSTEXPR limb limb_mask = static_cast<limb>((static_cast<ulimb>(1) << bits) - 1u);
+
+    // [f', g'] = [u v; q r] [f, g] / 2^bits
+    struct transition
+    {
+        limb u;
+        limb v;
+        limb q;
+        limb r;
+    };
+
+    static limb sign_mask(limb x)
+    {
+        return x >> sign_shift;
+    }
+
+    //
+    // bits divsteps on the low bits of f (odd) and g, updating delta and returning the transition
+    // matrix.  A divstep is (1 - delta, g, (g - f)/2) if delta > 0 and g is odd, otherwise
+    // (1 + delta, f, (g + (g mod 2) f)/2); it is done as a conditional swap and negation followed by
+    // the second form.  Step i only needs the low i + 1 bits of f and g.
+    //
+    static limb divsteps(limb delta, ulimb f, ulimb g, transition& t)
+    {
+        limb u = 1;
+        limb v = 0;
+        limb q = 0;
+        limb r = 1;
+        for (int i = 0; i < bits; ++i)
+        {
+            limb odd = static_cast<limb>(0u - (g & 1u));
+            limb swap = sign_mask(static_cast<limb>(-delta)) & odd;
+            // (delta, f, g) = (-delta, g, -f), and the rows of the matrix likewise:
+            ulimb x = (f ^ g) & static_cast<ulimb>(swap);
+            f ^= x;
+            g ^= x;
+            g = (g ^ static_cast<ulimb>(swap)) - static_cast<ulimb>(swap);
+            limb y = (u ^ q) & swap;
+            u ^= y;
+            q ^= y;
+            q = (q ^ swap) - swap;
+            y = (v ^ r) & swap;
+            v ^= y;
+            r ^= y;
+            r = (r ^ swap) - swap;
+            delta = (delta ^ swap) - swap;
+            // g is still odd if it was; add f and halve:
+            g += f & static_cast<ulimb>(odd);
+            q += u & odd;
+            r += v & odd;
+            g >>= 1;
+            u += u;
+            v += v;
+            ++delta;
+        }
+        t.u = u;
+        t.v = v;
+        t.q = q;
+        t.r = r;
+        return delta;
+    }
+
+    // [f, g] = t [f, g] / 2^bits, which is exact:
+    static void update_fg(limb* f, limb* g, const transition& t)
+    {
+        wide cf = static_cast<wide>(t.u) * f[0] + static_cast<wide>(t.v) * g[0];
+        wide cg = static_cast<wide>(t.q) * f[0] + static_cast<wide>(t.r) * g[0];
+        cf >>= bits;
+        cg >>= bits;
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            cf += static_cast<wide>(t.u) * f[i] + static_cast<wide>(t.v) * g[i];
+            cg += static_cast<wide>(t.q) * f[i] + static_cast<wide>(t.r) * g[i];
+            f[i - 1] = static_cast<limb>(cf) & limb_mask;
+            g[i - 1] = static_cast<limb>(cg) & limb_mask;
+            cf >>= bits;
+            cg >>= bits;
+        }
+        f[N - 1] = static_cast<limb>(cf);
+        g[N - 1] = static_cast<limb>(cg);
+    }
+
+    //
+    // [d, e] = t [d, e] / 2^bits mod m, for the cofactors with f = d*a and g = e*a (mod m).  Multiples
+    // md and me of m are added to clear the low bits before the shift; starting them at the entries
+    // of t for the negative ones keeps d and e in (-2m, m).  m_inverse is 1/m mod 2^bits.
+    //
+    static void update_de(limb* d, limb* e, const transition& t, const limb* m, limb m_inverse)
+    {
+        limb sd = sign_mask(d[N - 1]);
+        limb se = sign_mask(e[N - 1]);
+        limb md = (t.u & sd) + (t.v & se);
+        limb me = (t.q & sd) + (t.r & se);
+        wide cd = static_cast<wide>(t.u) * d[0] + static_cast<wide>(t.v) * e[0];
+        wide ce = static_cast<wide>(t.q) * d[0] + static_cast<wide>(t.r) * e[0];
+        md -= static_cast<limb>((static_cast<ulimb>(m_inverse) * static_cast<ulimb>(cd) + static_cast<ulimb>(md)) & static_cast<ulimb>(limb_mask));
+        me -= static_cast<limb>((static_cast<ulimb>(m_inverse) * static_cast<ulimb>(ce) + static_cast<ulimb>(me)) & static_cast<ulimb>(limb_mask));
+        cd += static_cast<wide>(m[0]) * md;
+        ce += static_cast<wide>(m[0]) * me;
+        cd >>= bits;
+        ce >>= bits;
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            cd += static_cast<wide>(t.u) * d[i] + static_cast<wide>(t.v) * e[i] + static_cast<wide>(m[i]) * md;
+            ce += static_cast<wide>(t.q) * d[i] + static_cast<wide>(t.r) * e[i] + static_cast<wide>(m[i]) * me;
+            d[i - 1] = static_cast<limb>(cd) & limb_mask;
+            e[i - 1] = static_cast<limb>(ce) & limb_mask;
+            cd >>= bits;
+            ce >>= bits;
+        }
+        d[N - 1] = static_cast<limb>(cd);
+        e[N - 1] = static_cast<limb>(ce);
+    }
+
+    // Propagates carries so that all limbs but the last are in [0, 2^bits):
+    static void normalize(limb* x)
+    {
+        for (std::size_t i = 0; i + 1 < N; ++i)
+        {
+            x[i + 1] += x[i] >> bits;
+            x[i] &= limb_mask;
+        }
+    }
+
+    static void negate_if(limb* x, limb condition)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = (x[i] ^ condition) - condition;
+        }
+        normalize(x);
+    }
+
+    static void add_if(limb* x, const limb* y, limb condition)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] += y[i] & condition;
+        }
+        normalize(x);
+    }
+
+    static void select(limb* x, const limb* y, limb condition)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] ^= (x[i] ^ y[i]) & condition;
+        }
+    }
+
+    // All ones if the normalized, nonnegative x is one, otherwise zero:
+    static limb is_one(const limb* x)
+    {
+        limb any = x[0] ^ 1;
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            any |= x[i];
+        }
+        return ~sign_mask(any | static_cast<limb>(-any));
+    }
+
+    // The number of trailing zero bits of the normalized, nonnegative x, N * bits for zero:
+    static limb trailing_zeros(const limb* x)
+    {
+        limb count = 0;
+        limb found = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < bits; ++j)
+            {
+                found |= (x[i] >> j) & 1;
+                count += 1 - found;
+            }
+        }
+        return count;
+    }
+
+    // x >> shift or x << shift for the normalized, nonnegative x, where shift is not secret:
+    static void shift_right(const limb* x, limb* y, int shift)
+    {
+        std::size_t q = static_cast<std::size_t>(shift / bits);
+        int s = shift % bits;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            ulimb low = i + q < N ? static_cast<ulimb>(x[i + q]) : 0u;
+            ulimb high = i + q + 1 < N ? static_cast<ulimb>(x[i + q + 1]) : 0u;
+            y[i] = static_cast<limb>(((low >> s) | (high << (bits - s))) & static_cast<ulimb>(limb_mask));
+        }
+    }
+
+    static void shift_left(const limb* x, limb* y, int shift)
+    {
+        std::size_t q = static_cast<std::size_t>(shift / bits);
+        int s = shift % bits;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            ulimb low = i >= q + 1 ? static_cast<ulimb>(x[i - q - 1]) : 0u;
+            ulimb high = i >= q ? static_cast<ulimb>(x[i - q]) : 0u;
+            y[i] = static_cast<limb>(((high << s) | (low >> (bits - s))) & static_cast<ulimb>(limb_mask));
+        }
+    }
+
+    // x >> shift or x << shift for a secret shift in [0, N * bits], one power of two at a time:
+    static void shift_by(limb* x, limb shift, bool left)
+    {
+        limb y[N];
+        for (int k = 1; k <= static_cast<int>(N) * bits; k *= 2)
+        {
+            if (left)
+            {
+                shift_left(x, y, k);
+            }
+            else
+            {
+                shift_right(x, y, k);
+            }
+            select(x, y, static_cast<limb>(-((shift / k) & 1)));
+        }
+    }
+
+    //
+    // gcd(a, b) for normalized, nonnegative a and b of at most digits bits, with batches as in
+    // safegcd_size: the common power of two is removed, the odd one of the two becomes f, and f is
+    // plus or minus the gcd once g is zero.
+    //
+    static void gcd(limb* a, limb* b, int batches)
+    {
+        limb c[N];
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            c[i] = a[i] | b[i];
+        }
+        limb shift = trailing_zeros(c);
+        shift_by(a, shift, false);
+        shift_by(b, shift, false);
+        // a becomes f, swapping if it is even:
+        limb swap = static_cast<limb>((a[0] & 1) - 1);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            limb x = (a[i] ^ b[i]) & swap;
+            a[i] ^= x;
+            b[i] ^= x;
+        }
+        limb delta = 1;
+        transition t;
+        for (int i = 0; i < batches; ++i)
+        {
+            delta = divsteps(delta, static_cast<ulimb>(a[0]), static_cast<ulimb>(b[0]), t);
+            update_fg(a, b, t);
+        }
+        negate_if(a, sign_mask(a[N - 1]));
+        shift_by(a, shift, true);
+    }
+
+    //
+    // Sets x to 1/a mod m, in [0, m), for odd m > 1 and a of at most digits bits, both normalized
+    // and nonnegative, and returns all ones; or sets x to zero and returns zero if there is no inverse.
+    //
+    static limb inverse(limb* x, const limb* a, const limb* m, limb m_inverse, int batches)
+    {
+        limb f[N];
+        limb g[N];
+        limb e[N];
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            f[i] = m[i];
+            g[i] = a[i];
+            x[i] = 0;
+            e[i] = 0;
+        }
+        e[0] = 1;
+        limb delta = 1;
+        transition t;
+        for (int i = 0; i < batches; ++i)
+        {
+            delta = divsteps(delta, static_cast<ulimb>(f[0]), static_cast<ulimb>(g[0]), t);
+            update_fg(f, g, t);
+            update_de(x, e, t, m, m_inverse);
+        }
+        // f = x*a = +-gcd (mod m), with x in (-2m, m); fix the sign and reduce into [0, m):
+        limb negative = sign_mask(f[N - 1]);
+        negate_if(f, negative);
+        negate_if(x, negative);
+        add_if(x, m, sign_mask(x[N - 1]));
+        add_if(x, m, sign_mask(x[N - 1]));
+        limb y[N];
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            y[i] = x[i] - m[i];
+        }
+        normalize(y);
+        select(x, y, ~sign_mask(y[N - 1]));
+        limb ok = is_one(f);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] &= ok;
+        }
+        return ok;
+    }
+};
+
+//
+// Conversion to and from limbs.  Shifts are done in two halves, each narrower than any type here.
+//
+template<class Traits, class T>
+void to_limbs(const T& a, typename Traits::limb* x, std::size_t n)
+{
+    T v = a;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = static_cast<typename Traits::limb>(static_cast<typename Traits::ulimb>(v & T((static_cast<typename Traits::ulimb>(1) << Traits::bits) - 1u)));
+        v >>= Traits::bits / 2;
+        v >>= Traits::bits - Traits::bits / 2;
+    }
+}
+
+template<class Traits, class T>
+T from_limbs(const typename Traits::limb* x, std::size_t n)
+{
+    T v = 0;
+    for (std::size_t i = n; i-- > 0;)
+    {
+        v <<= Traits::bits / 2;
+        v <<= Traits::bits - Traits::bits / 2;
+        v |= T(static_cast<typename Traits::ulimb>(x[i]));
+    }
+    return v;
+}
+
+template<class Traits, class T>
+T gcd_ct(const T& a, const T& b)
+{
+    typedef safegcd_size< Traits, std::numeric_limits<T>::digits > size;
+    typedef safegcd< Traits, size::limbs > core;
+    typename Traits::limb x[size::limbs];
+    typename Traits::limb y[size::limbs];
+    to_limbs<Traits>(a, x, size::limbs);
+    to_limbs<Traits>(b, y, size::limbs);
+    core::gcd(x, y, size::batches);
+    return from_limbs<Traits, T>(x, size::limbs);
+}
+
+template<class Traits, class T>
+T mod_inverse_ct(const T& a, const T& modulus)
+{
+    typedef safegcd_size< Traits, std::numeric_limits<T>::digits > size;
+    typedef safegcd< Traits, size::limbs > core;
+    if (modulus < T(3) || (modulus & 1u) == 0u)
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("mod_inverse_ct: modulus must be odd and > 1"));
+    }
+    typename Traits::limb x[size::limbs];
+    typename Traits::limb m[size::limbs];
+    typename Traits::limb result[size::limbs];
+    to_limbs<Traits>(a, x, size::limbs);
+    to_limbs<Traits>(modulus, m, size::limbs);
+    typename Traits::limb m_inverse = static_cast<typename Traits::limb>(boost::integer::inverse_mod_pow2(static_cast<typename Traits::ulimb>(m[0])) & static_cast<typename Traits::ulimb>(core::limb_mask));
+    core::inverse(result, x, m, m_inverse, size::batches);
+    return from_limbs<Traits, T>(result, size::limbs);
+}
+
+} // namespace safegcd_detail
+
+//
+// gcd(a, b) for unsigned builtin or fixed width multiprecision types, by a sequence of operations
+// which depends only on the type, not the values.
+//
+template<class T>
+T gcd_ct(const T& a, const T& b)
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<T>::is_integer && std::numeric_limits<T>::is_bounded && !std::numeric_limits<T>::is_signed,
+        "gcd_ct supports unsigned fixed width types only.");
+    return safegcd_detail::gcd_ct<safegcd_detail::limb_traits>(a, b);
+}
+
+//
+// 1/a mod modulus in [0, modulus), or zero if there is none, likewise independently of the value of a,
+// though not of modulus, which is not treated as secret.  a may exceed modulus.  Throws
+// std::domain_error unless modulus is odd and greater than one.
+//
+template<class T>
+T mod_inverse_ct(const T& a, const T& modulus)
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<T>::is_integer && std::numeric_limits<T>::is_bounded && !std::numeric_limits<T>::is_signed,
+        "mod_inverse_ct supports unsigned fixed width types only.");
+    return safegcd_detail::mod_inverse_ct<safegcd_detail::limb_traits>(a, modulus);
+}
+
+}}
+#endif
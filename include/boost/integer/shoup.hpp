@@ -0,0 +1,163 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_SHOUP_HPP
+#define BOOST_INTEGER_SHOUP_HPP
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+//
+// Shoup's multiplication by a constant w modulo p: with w' = floor(w*2^N/p) for the width N of T,
+// q = floor(a*w'/2^N) is the quotient of a*w by p or one less, for any a < 2^N, so a*w - q*p is in
+// [0, 2p) and is found from the low halves of the products alone.  p <= 2^(N-1) keeps that below 2^N.
+//
+template<class T>
+struct shoup_traits
+{
+    typedef typename montgomery_wide< typename montgomery_method< T >::word_type >::type wide_type;
+    BOOST_STATIC_CONSTEXPR int bits = std::numeric_limits<T>::digits;
+};
+
+template<class T>
+BOOST_CXX14_CONSTEXPR inline T shoup_check_modulus(const T& p)
+{
+    if (p == 0u || (static_cast<T>(p - 1u) >> (shoup_traits< T >::bits - 1)) != 0u)
+    {
+        BOOST_THROW_EXCEPTION(std::domain_error("shoup_multiplier: modulus must be in [1, 2^(N-1)]"));
+    }
+    return p;
+}
+
+// w in [0, p):
+template<class T>
+BOOST_CXX14_CONSTEXPR inline T shoup_quotient(T w, T p) BOOST_NOEXCEPT
+{
+    typedef typename shoup_traits< T >::wide_type wide_type;
+    return static_cast<T>((static_cast<wide_type>(w) << shoup_traits< T >::bits) / p);
+}
+
+// a*w mod p, plus p or not:
+template<class T>
+BOOST_CXX14_CONSTEXPR inline T shoup_mul_lazy(T a, T w, T w_quotient, T p) BOOST_NOEXCEPT
+{
+    typedef typename shoup_traits< T >::wide_type wide_type;
+    const T q = static_cast<T>((static_cast<wide_type>(a) * w_quotient) >> shoup_traits< T >::bits);
+    return static_cast<T>(static_cast<T>(static_cast<wide_type>(a) * w) - static_cast<T>(static_cast<wide_type>(q) * p));
+}
+
+template<class T>
+BOOST_CXX14_CONSTEXPR inline T shoup_mul(T a, T w, T w_quotient, T p) BOOST_NOEXCEPT
+{
+    const T r = shoup_mul_lazy(a, w, w_quotient, p);
+    return r >= p ? static_cast<T>(r - p) : r;
+}
+
+} // namespace modular_detail
+
+//
+// Multiplication by a fixed w modulo p with two multiplications and a conditional subtraction.  T is
+// an unsigned builtin type of up to 64 bits (32 without a 128-bit integer type) and p in [1, 2^(N-1)]
+// for the width N of T; the constructor throws std::domain_error for any other p.  The value
+// multiplied may be any value of T.
+//
+template<class T>
+class shoup_multiplier
+{
+    BOOST_STATIC_ASSERT_MSG(boost::is_integral<T>::value && !std::numeric_limits<T>::is_signed && modular_detail::montgomery_method< T >::value,
+        "shoup_multiplier supports unsigned builtin types with a type of twice their width only.");
+
+    T modulus_;
+    T multiplier_;
+    T quotient_;
+
+public:
+    BOOST_CXX14_CONSTEXPR shoup_multiplier(const T& w, const T& p)
+        : modulus_(modular_detail::shoup_check_modulus(p)),
+          multiplier_(static_cast<T>(w % p)),
+          quotient_(modular_detail::shoup_quotient(multiplier_, modulus_))
+    {}
+
+    BOOST_CXX14_CONSTEXPR const T& modulus() const BOOST_NOEXCEPT
+    {
+        return modulus_;
+    }
+    // w mod p:
+    BOOST_CXX14_CONSTEXPR const T& multiplier() const BOOST_NOEXCEPT
+    {
+        return multiplier_;
+    }
+    // floor(w*2^N/p):
+    BOOST_CXX14_CONSTEXPR const T& quotient() const BOOST_NOEXCEPT
+    {
+        return quotient_;
+    }
+
+    // a*w mod p:
+    BOOST_CXX14_CONSTEXPR T mul(const T& a) const BOOST_NOEXCEPT
+    {
+        return modular_detail::shoup_mul(a, multiplier_, quotient_, modulus_);
+    }
+    // A value in [0, 2p) congruent to a*w, saving the subtraction where it can be deferred:
+    BOOST_CXX14_CONSTEXPR T mul_lazy(const T& a) const BOOST_NOEXCEPT
+    {
+        return modular_detail::shoup_mul_lazy(a, multiplier_, quotient_, modulus_);
+    }
+
+    // out[i] = a[i]*w mod p for i < n; out may be a.
+    void mul(const T* a, T* out, std::size_t n) const BOOST_NOEXCEPT
+    {
+        const T w = multiplier_;
+        const T w_quotient = quotient_;
+        const T p = modulus_;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = modular_detail::shoup_mul(a[i], w, w_quotient, p);
+        }
+    }
+};
+
+//
+// The same for a table of multipliers, as in the twiddle factors of a number theoretic transform:
+// shoup_precompute sets w_quotient[i] = floor(w[i]*2^N/p) for each w[i] in [0, p), and shoup_mul
+// sets out[i] = a[i]*w[i] mod p.  Both throw std::domain_error unless p is in [1, 2^(N-1)]; out may
+// be a.
+//
+template<class T>
+void shoup_precompute(const T* w, T* w_quotient, std::size_t n, const T& p)
+{
+    BOOST_STATIC_ASSERT_MSG(boost::is_integral<T>::value && !std::numeric_limits<T>::is_signed && modular_detail::montgomery_method< T >::value,
+        "shoup_precompute supports unsigned builtin types with a type of twice their width only.");
+    modular_detail::shoup_check_modulus(p);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        w_quotient[i] = modular_detail::shoup_quotient(w[i], p);
+    }
+}
+
+template<class T>
+void shoup_mul(const T* a, const T* w, const T* w_quotient, T* out, std::size_t n, const T& p)
+{
+    BOOST_STATIC_ASSERT_MSG(boost::is_integral<T>::value && !std::numeric_limits<T>::is_signed && modular_detail::montgomery_method< T >::value,
+        "shoup_mul supports unsigned builtin types with a type of twice their width only.");
+    const T m = modular_detail::shoup_check_modulus(p);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[i] = modular_detail::shoup_mul(a[i], w[i], w_quotient[i], m);
+    }
+}
+
+}}
+#endif
@@ -0,0 +1,260 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef BOOST_INTEGER_STATIC_MODINT_HPP
+#define BOOST_INTEGER_STATIC_MODINT_HPP
+#include <limits>
+#include <stdexcept>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/integer.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/core/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/integer/common_factor_ct.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/integer/barrett.hpp>
+#include <boost/integer/montgomery.hpp>
+#include <boost/integer/mod_pow.hpp>
+#include <boost/integer/detail/modular_multiply.hpp>
+
+namespace boost { namespace integer {
+
+namespace modular_detail {
+
+// The word static_modint<M> computes in: 32 bits for M < 2^32, else 64 where there is a 128-bit type.
+template<static_gcd_type M>
+struct static_modint_word
+{
+    typedef typename boost::uint_value_t< M >::least least_type;
+    static const bool value = montgomery_method< least_type >::value;
+    typedef typename montgomery_method< least_type >::word_type type;
+};
+
+//
+// Products modulo a constant M of at most 32 bits, reduced in 64 bits: compilers replace the
+// division by M with a multiplication by a reciprocal of M they compute themselves, which is
+// Barrett's reduction with no run time setup and faster here than barrett_word.  Wider products
+// would need a library call for the division.
+//
+template<class U, static_gcd_type M>
+struct static_divisor
+{
+    typedef typename montgomery_wide< U >::type wide_type;
+
+    U one;      // 1 mod M
+
+    BOOST_CXX14_CONSTEXPR explicit static_divisor(U) BOOST_NOEXCEPT : one(M == 1u ? 0u : 1u) {}
+
+    BOOST_CXX14_CONSTEXPR U mul(U a, U b) const BOOST_NOEXCEPT
+    {
+        return static_cast<U>(static_cast<wide_type>(a) * b % static_cast<wide_type>(M));
+    }
+};
+
+// Montgomery's method holds a as aR mod M; the others hold a itself.
+template<class U, static_gcd_type M, bool Montgomery>
+struct static_modint_engine
+{
+    typedef montgomery_word< U > type;
+
+    static BOOST_CXX14_CONSTEXPR U load(const type& mult, U a) BOOST_NOEXCEPT
+    {
+        return mult.to_montgomery(a);
+    }
+    static BOOST_CXX14_CONSTEXPR U store(const type& mult, U x) BOOST_NOEXCEPT
+    {
+        return mult.from_montgomery(x);
+    }
+};
+
+template<class U, static_gcd_type M>
+struct static_modint_engine<U, M, false>
+{
+    typedef typename boost::conditional<(std::numeric_limits<U>::digits <= 32), static_divisor< U, M >, barrett_word< U > >::type type;
+
+    static BOOST_CXX14_CONSTEXPR U load(const type&, U a) BOOST_NOEXCEPT
+    {
+        return a;
+    }
+    static BOOST_CXX14_CONSTEXPR U store(const type&, U x) BOOST_NOEXCEPT
+    {
+        return x;
+    }
+};
+
+//
+// The constants of the modulus, one object for each M, computed during compilation where constexpr
+// allows loops, and otherwise on first use.
+//
+template<class U, static_gcd_type M, bool Montgomery>
+struct static_modint_constants
+{
+    typedef typename static_modint_engine< U, M, Montgomery >::type type;
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+    static constexpr type mult = type(static_cast<U>(M));
+#else
+    static const type mult;
+#endif
+};
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+#ifdef BOOST_NO_CXX17_INLINE_VARIABLES
+template<class U, static_gcd_type M, bool Montgomery>
+constexpr typename static_modint_constants< U, M, Montgomery >::type static_modint_constants< U, M, Montgomery >::mult;
+#endif
+#else
+template<class U, static_gcd_type M, bool Montgomery>
+const typename static_modint_constants< U, M, Montgomery >::type static_modint_constants< U, M, Montgomery >::mult(static_cast<U>(M));
+#endif
+
+// Montgomery's method is the fastest for odd moduli above 32 bits:
+template<static_gcd_type M>
+struct static_modint_montgomery
+{
+    static const bool value = M > 1u && static_gcd< M, 2u >::value == 1u
+        && std::numeric_limits< typename static_modint_word< M >::type >::digits > 32;
+};
+
+} // namespace modular_detail
+
+//
+// An integer modulo a modulus M fixed at compile time, 0 < M < 2^64 (2^32 without a 128-bit integer
+// type), held in [0, M).  All the constants of the reduction are computed during compilation, so
+// that each operator is a few multiplications.  Products are Montgomery's when Montgomery is true,
+// by default for odd M >= 2^32; otherwise they are reduced by the constant M for M < 2^32, and by
+// Barrett's method above.  A modulus out of range, or Montgomery's method with an even modulus,
+// fails to compile.
+//
+template<static_gcd_type M, bool Montgomery = modular_detail::static_modint_montgomery< M >::value>
+class static_modint
+{
+    BOOST_STATIC_ASSERT_MSG(M > 0u, "static_modint: modulus must be > 0.");
+    BOOST_STATIC_ASSERT_MSG(modular_detail::static_modint_word< M >::value,
+        "static_modint: modulus must be below 2^64, or 2^32 without a 128-bit integer type.");
+    // Montgomery's R is a power of two, which M must be coprime to:
+    BOOST_STATIC_ASSERT_MSG(!Montgomery || (M > 1u && static_gcd< M, 2u >::value == 1u),
+        "static_modint: Montgomery's method needs an odd modulus > 1.");
+
+public:
+    typedef typename modular_detail::static_modint_word< M >::type value_type;
+
+private:
+    typedef modular_detail::static_modint_engine< value_type, M, Montgomery > engine;
+    typedef modular_detail::static_modint_constants< value_type, M, Montgomery > constants;
+
+    value_type value_;   // in the engine's representation, in [0, M)
+
+    struct raw_tag {};
+    BOOST_CXX14_CONSTEXPR static_modint(value_type x, raw_tag) BOOST_NOEXCEPT : value_(x) {}
+
+    // a mod M for any a; the divisions are by constants, which compilers turn into multiplications.
+    template<class I>
+    static BOOST_CXX14_CONSTEXPR value_type residue(const I& a, const boost::false_type&) BOOST_NOEXCEPT
+    {
+        typedef typename boost::conditional<(std::numeric_limits<I>::digits > std::numeric_limits<boost::uintmax_t>::digits), I, boost::uintmax_t>::type unsigned_type;
+        return static_cast<value_type>(static_cast<unsigned_type>(a) % static_cast<unsigned_type>(M));
+    }
+    template<class I>
+    static BOOST_CXX14_CONSTEXPR value_type residue(const I& a, const boost::true_type&) BOOST_NOEXCEPT
+    {
+        typedef typename boost::make_unsigned< I >::type unsigned_type;
+        if (a < I(0))
+        {
+            const value_type r = residue(static_cast<unsigned_type>(unsigned_type(0) - static_cast<unsigned_type>(a)), boost::false_type());
+            return r == 0u ? r : static_cast<value_type>(static_cast<value_type>(M) - r);
+        }
+        return residue(static_cast<unsigned_type>(a), boost::false_type());
+    }
+
+public:
+    BOOST_CXX14_CONSTEXPR static_modint() BOOST_NOEXCEPT : value_(0) {}
+
+    // a mod M, for a of any builtin integer type:
+    template<class I>
+    BOOST_CXX14_CONSTEXPR static_modint(const I& a, typename boost::enable_if_c<boost::is_integral<I>::value>::type* = 0) BOOST_NOEXCEPT
+        : value_(engine::load(constants::mult, residue(a, boost::integral_constant<bool, std::numeric_limits<I>::is_signed>())))
+    {}
+
+    static BOOST_CXX14_CONSTEXPR value_type modulus() BOOST_NOEXCEPT
+    {
+        return static_cast<value_type>(M);
+    }
+
+    // The residue in [0, M):
+    BOOST_CXX14_CONSTEXPR value_type value() const BOOST_NOEXCEPT
+    {
+        return engine::store(constants::mult, value_);
+    }
+
+    BOOST_CXX14_CONSTEXPR static_modint& operator+=(const static_modint& b) BOOST_NOEXCEPT
+    {
+        value_ = modular_detail::add_mod(value_, b.value_, static_cast<value_type>(M));
+        return *this;
+    }
+    BOOST_CXX14_CONSTEXPR static_modint& operator-=(const static_modint& b) BOOST_NOEXCEPT
+    {
+        value_ = modular_detail::sub_mod(value_, b.value_, static_cast<value_type>(M));
+        return *this;
+    }
+    BOOST_CXX14_CONSTEXPR static_modint& operator*=(const static_modint& b) BOOST_NOEXCEPT
+    {
+        value_ = constants::mult.mul(value_, b.value_);
+        return *this;
+    }
+
+    BOOST_CXX14_CONSTEXPR static_modint operator-() const BOOST_NOEXCEPT
+    {
+        return static_modint(value_ == 0u ? value_ : static_cast<value_type>(static_cast<value_type>(M) - value_), raw_tag());
+    }
+
+    friend BOOST_CXX14_CONSTEXPR static_modint operator+(static_modint a, const static_modint& b) BOOST_NOEXCEPT
+    {
+        return a += b;
+    }
+    friend BOOST_CXX14_CONSTEXPR static_modint operator-(static_modint a, const static_modint& b) BOOST_NOEXCEPT
+    {
+        return a -= b;
+    }
+    friend BOOST_CXX14_CONSTEXPR static_modint operator*(static_modint a, const static_modint& b) BOOST_NOEXCEPT
+    {
+        return a *= b;
+    }
+    friend BOOST_CXX14_CONSTEXPR bool operator==(const static_modint& a, const static_modint& b) BOOST_NOEXCEPT
+    {
+        return a.value_ == b.value_;
+    }
+    friend BOOST_CXX14_CONSTEXPR bool operator!=(const static_modint& a, const static_modint& b) BOOST_NOEXCEPT
+    {
+        return a.value_ != b.value_;
+    }
+
+    // This value raised to the power e >= 0 of any integer type, by sliding windows; x^0 is 1 mod M.
+    // Throws std::domain_error if e < 0.
+    template<class E>
+    BOOST_CXX14_CONSTEXPR static_modint pow(const E& e) const
+    {
+        if (modular_detail::exponent_negative(e, boost::integral_constant<bool, std::numeric_limits<E>::is_signed>()))
+        {
+            BOOST_THROW_EXCEPTION(std::domain_error("static_modint: exponent must be >= 0"));
+        }
+        return static_modint(modular_detail::sliding_pow(constants::mult, value_, e), raw_tag());
+    }
+
+    // The inverse of this value, or zero if there is none:
+    BOOST_CXX14_CONSTEXPR static_modint inverse() const BOOST_NOEXCEPT
+    {
+        value_type result = 0;
+        boost::integer::mod_inverse(value(), static_cast<value_type>(M), result);
+        return static_modint(result);
+    }
+};
+
+}}
+#endif
@@ -177,11 +177,19 @@ template < static_gcd_type Value1, static_gcd_type Value2 >
 
 //  From <boost/integer/common_factor_rt.hpp>
 
-template < typename IntegerType >
+template < typename IntegerType = void >
     class gcd_evaluator;
-template < typename IntegerType >
+template < typename IntegerType = void >
     class lcm_evaluator;
 
+
+//  From <boost/integer/gcd_accumulator.hpp>
+
+template < typename IntegerType >
+    class gcd_accumulator;
+template < typename IntegerType >
+    class lcm_accumulator;
+
 } // namespace integer
 
 }  // namespace boost
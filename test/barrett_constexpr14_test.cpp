@@ -0,0 +1,18 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/barrett.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+void test_constexpr1()
+{
+   constexpr boost::integer::barrett_context<boost::uint64_t> ctx(1000000000000000000ull);
+   static_assert(ctx.reduce(0xFFFFFFFFFFFFFFFFull) == 446744073709551615ull, "Expected result not correct in constexpr barrett_context.");
+   static_assert(ctx.mulmod(999999999999999999ull, 999999999999999999ull) == 1u, "Expected result not correct in constexpr barrett_context.");
+   static_assert(ctx.powmod(10u, 17u) == 100000000000000000ull, "Expected result not correct in constexpr barrett_context.");
+}
+
+#endif
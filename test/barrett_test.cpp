@@ -0,0 +1,112 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include "modular_test_values.hpp"
+#include <boost/integer/barrett.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::barrett_context;
+
+template<class T>
+void check_modulus(const T& m, int count = 100)
+{
+    const barrett_context<T> ctx(m);
+    const cpp_int cm = to_cpp_int(m);
+    BOOST_TEST(ctx.modulus() == m);
+
+    std::vector<T> a = modular_test_values(m, count);
+    std::vector<T> b;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const T r = ctx.reduce(a[i]);
+        BOOST_TEST(to_cpp_int(r) == to_cpp_int(a[i]) % cm);
+        if (!b.empty())
+        {
+            BOOST_TEST(to_cpp_int(ctx.mulmod(r, b.back())) == to_cpp_int(r) * to_cpp_int(b.back()) % cm);
+        }
+        const unsigned e = static_cast<unsigned>(i * 9);
+        BOOST_TEST(to_cpp_int(ctx.powmod(a[i], e)) == boost::multiprecision::powm(to_cpp_int(a[i]), e, cm));
+        b.push_back(r);
+    }
+    BOOST_TEST(to_cpp_int(ctx.powmod(a.back(), m)) == boost::multiprecision::powm(to_cpp_int(a.back()), cm, cm));
+
+    // The array forms, out of and in place:
+    std::vector<T> out(a.size());
+    ctx.reduce(a.data(), out.data(), a.size());
+    BOOST_TEST(out == b);
+    ctx.reduce(a.data(), a.data(), a.size());
+    BOOST_TEST(a == b);
+    std::vector<T> c(b.rbegin(), b.rend());
+    ctx.mulmod(b.data(), c.data(), out.data(), b.size());
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        BOOST_TEST(to_cpp_int(out[i]) == to_cpp_int(b[i]) * to_cpp_int(c[i]) % cm);
+    }
+    ctx.mulmod(b.data(), c.data(), b.data(), b.size());
+    BOOST_TEST(out == b);
+}
+
+template<class T>
+void test_barrett()
+{
+    // The reference results are slow for wide types:
+    const int count = std::numeric_limits<T>::digits > 128 ? 10 : 100;
+    const int small[] = { 1, 2, 3, 4, 5, 6, 10, 64, 100, 127, 128, 255 };
+    for (std::size_t i = 0; i < sizeof(small) / sizeof(small[0]); ++i)
+    {
+        check_modulus(T(small[i]), count);
+    }
+    const T top = (std::numeric_limits<T>::max)();
+    check_modulus(top, count);
+    check_modulus(T(top - 1u), count);
+    check_modulus(T(top / 3u), count);
+    check_modulus(T(T(top / 2u) + 1u), count);
+    check_modulus(T(T(top / 2u) + 2u), count);
+    // Powers of two, and moduli of every width:
+    for (int k = 1; k < std::numeric_limits<T>::digits; k += 1 + std::numeric_limits<T>::digits / 16)
+    {
+        check_modulus(T(T(1u) << k), 10);
+        check_modulus(T(T(T(1u) << k) + T(T(1u) << (k / 2)) + 2u), 10);
+    }
+
+    BOOST_TEST_THROWS(barrett_context<T>(T(0)), std::domain_error);
+}
+
+// A width which is not a multiple of the limb size:
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<521, 521,
+    boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void> > uint521_t;
+
+int main()
+{
+    test_barrett<boost::uint8_t>();
+    test_barrett<boost::uint16_t>();
+    test_barrett<boost::uint32_t>();
+    test_barrett<boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_barrett<boost::uint128_type>();
+#endif
+    test_barrett<boost::multiprecision::uint128_t>();
+    test_barrett<boost::multiprecision::uint256_t>();
+    test_barrett<uint521_t>();
+    test_barrett<boost::multiprecision::uint1024_t>();
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
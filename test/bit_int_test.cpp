@@ -0,0 +1,89 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer.hpp>
+#include <boost/integer/common_factor.hpp>
+#include <boost/integer/integer_log2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#ifdef BOOST_INTEGER_HAS_BITINT
+
+#pragma clang diagnostic ignored "-Wbit-int-extension"
+
+BOOST_STATIC_ASSERT((boost::is_same<boost::uint_t<96>::least, unsigned _BitInt(96)>::value));
+BOOST_STATIC_ASSERT((boost::is_same<boost::uint_t<256>::fast, unsigned _BitInt(256)>::value));
+BOOST_STATIC_ASSERT((boost::is_same<boost::int_t<192>::least, _BitInt(192)>::value));
+// Widths the standard types cover are unchanged:
+BOOST_STATIC_ASSERT((boost::is_same<boost::uint_t<64>::least, boost::uint_t<64>::exact>::value));
+BOOST_STATIC_ASSERT((boost::is_same<boost::int_t<33>::least, boost::int_t<64>::least>::value));
+
+template <class T>
+T power_of_two(int n)
+{
+   return static_cast<T>(T(1) << n);
+}
+
+template <int N>
+void test_unsigned()
+{
+   typedef typename boost::uint_t<N>::least T;
+
+   BOOST_TEST_EQ(boost::integer_log2(T(1)), 0);
+   for (int i = 0; i < N; i += 7)
+   {
+      BOOST_TEST_EQ(boost::integer_log2(power_of_two<T>(i)), i);
+      BOOST_TEST_EQ(boost::integer_log2(static_cast<T>(power_of_two<T>(i) | 1u)), i);
+   }
+   BOOST_TEST_EQ(boost::integer_log2(static_cast<T>(~T(0))), N - 1);
+
+   // Products of primes placed so that factors span limb boundaries:
+   const T p = static_cast<T>(power_of_two<T>(N / 3) + 1);
+   const T a = static_cast<T>(p * T(3) * T(1000003));
+   const T b = static_cast<T>(p * T(5) * T(999983));
+   BOOST_TEST(boost::integer::gcd(a, b) == p);
+   BOOST_TEST(boost::integer::gcd(static_cast<T>(a << 3), static_cast<T>(b << 5)) == static_cast<T>(p << 3));
+   BOOST_TEST(boost::integer::gcd(a, T(0)) == a);
+   BOOST_TEST(boost::integer::gcd(T(0), b) == b);
+   BOOST_TEST(boost::integer::gcd(power_of_two<T>(N - 1), power_of_two<T>(N - 2)) == power_of_two<T>(N - 2));
+   BOOST_TEST(boost::integer::lcm(static_cast<T>(p * T(6)), static_cast<T>(p * T(10))) == static_cast<T>(p * T(30)));
+
+   // All three algorithms agree:
+   BOOST_TEST(boost::integer::gcd_detail::Euclid_gcd(a, b) == p);
+   BOOST_TEST(boost::integer::gcd_detail::Stein_gcd(a, b) == p);
+   BOOST_TEST(boost::integer::gcd_detail::mixed_binary_gcd(a, b) == p);
+}
+
+template <int N>
+void test_signed()
+{
+   typedef typename boost::int_t<N>::least T;
+
+   BOOST_TEST_EQ(boost::integer_log2(static_cast<T>(T(1) << (N - 2))), N - 2);
+   const T p = static_cast<T>((T(1) << (N / 2)) + 1);
+   BOOST_TEST(boost::integer::gcd(static_cast<T>(-p * T(6)), static_cast<T>(p * T(9))) == static_cast<T>(p * T(3)));
+   BOOST_TEST(boost::integer::lcm(static_cast<T>(-p * T(6)), static_cast<T>(-p * T(9))) == static_cast<T>(p * T(18)));
+}
+
+int main()
+{
+   test_unsigned<65>();
+   test_unsigned<96>();
+   test_unsigned<128>();
+   test_unsigned<192>();
+   test_unsigned<256>();
+   test_signed<96>();
+   test_signed<256>();
+
+   return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+   return boost::report_errors();
+}
+
+#endif
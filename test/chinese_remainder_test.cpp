@@ -0,0 +1,233 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/integer/chinese_remainder.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::crt_basis;
+
+// A simple generator, so that the values are the same on every platform:
+struct lcg
+{
+    boost::uint64_t state;
+    boost::uint64_t operator()()
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 11;
+    }
+    cpp_int below(const cpp_int& m)
+    {
+        cpp_int x = 0;
+        for (cpp_int t = m; t != 0; t >>= 53)
+        {
+            x = (x << 53) | (*this)();
+        }
+        return x % m;
+    }
+};
+
+cpp_int residue(const cpp_int& x, const cpp_int& m)
+{
+    cpp_int r = x % m;
+    return r < 0 ? cpp_int(r + m) : r;
+}
+
+// Whether residues a modulo moduli m have a common solution: a[i] = a[j] mod gcd(m[i], m[j]).
+template<class Z>
+bool consistent(const std::vector<Z>& a, const std::vector<Z>& m)
+{
+    for (std::size_t i = 0; i < m.size(); ++i)
+    {
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            const cpp_int g = boost::multiprecision::gcd(cpp_int(m[i]), cpp_int(m[j]));
+            if (residue(cpp_int(a[i]) - cpp_int(a[j]), g) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//
+// Round trips x -> residues -> x for x in [0, M) and against the residues of x shifted by multiples of
+// the moduli, then arbitrary residues, which need not be consistent when the moduli are not coprime;
+// and the same through the array form.
+//
+template<class Z, class R>
+void check_moduli(const std::vector<Z>& m, int count)
+{
+    const crt_basis<Z, R> basis(m.begin(), m.end());
+    const std::size_t n = m.size();
+    BOOST_TEST_EQ(basis.size(), n);
+    cpp_int lcm = 1;
+    bool coprime = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        BOOST_TEST(basis.modulus(i) == m[i]);
+        coprime = coprime && boost::multiprecision::gcd(lcm, cpp_int(m[i])) == 1;
+        lcm = boost::multiprecision::lcm(lcm, cpp_int(m[i]));
+    }
+    BOOST_TEST(cpp_int(basis.product()) == lcm);
+    BOOST_TEST_EQ(basis.coprime(), coprime);
+
+    lcg gen = { 12345u + n };
+    std::vector<Z> all;
+    std::vector<cpp_int> expected;
+    std::size_t inconsistent = 0;
+    for (int j = 0; j < count; ++j)
+    {
+        std::vector<Z> a(n);
+        const cpp_int x = j == 0 ? cpp_int(0) : j == 1 ? cpp_int(lcm - 1) : gen.below(lcm);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // Residues of any value of Z:
+            cpp_int shifted = residue(x, cpp_int(m[i]));
+            if (j % 3 == 2 && cpp_int(m[i]) <= cpp_int((std::numeric_limits<Z>::max)()) - shifted)
+            {
+                shifted += cpp_int(m[i]);
+            }
+            if (std::numeric_limits<Z>::is_signed && j % 3 == 1)
+            {
+                shifted -= cpp_int(m[i]);
+            }
+            a[i] = static_cast<Z>(shifted);
+        }
+        R result = R(1);
+        BOOST_TEST(basis.reconstruct(a.data(), result));
+        BOOST_TEST(cpp_int(result) == x);
+        BOOST_TEST(cpp_int(basis.reconstruct(a.data())) == x);
+        all.insert(all.end(), a.begin(), a.end());
+        expected.push_back(x);
+
+        // Arbitrary residues:
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<Z>(gen.below(cpp_int(m[i])));
+        }
+        const bool solvable = consistent(a, m);
+        BOOST_TEST_EQ(basis.reconstruct(a.data(), result), solvable);
+        if (solvable)
+        {
+            BOOST_TEST(cpp_int(result) < lcm);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                BOOST_TEST(residue(cpp_int(result), cpp_int(m[i])) == cpp_int(a[i]));
+            }
+            BOOST_TEST(basis.reconstruct(a.data()) == result);
+        }
+        else
+        {
+            BOOST_TEST(result == R(0));
+            BOOST_TEST_THROWS(basis.reconstruct(a.data()), std::domain_error);
+            ++inconsistent;
+        }
+        all.insert(all.end(), a.begin(), a.end());
+        expected.push_back(solvable ? cpp_int(result) : cpp_int(0));
+    }
+    if (coprime)
+    {
+        BOOST_TEST_EQ(inconsistent, 0u);
+    }
+
+    std::vector<R> out(expected.size(), R(1));
+    BOOST_TEST_EQ(basis.reconstruct(all.data(), out.data(), out.size()), inconsistent);
+    for (std::size_t j = 0; j < out.size(); ++j)
+    {
+        BOOST_TEST(cpp_int(out[j]) == expected[j]);
+    }
+}
+
+template<class Z, class R>
+void check_moduli(const boost::uint64_t* first, std::size_t n, int count = 150)
+{
+    std::vector<Z> m;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        m.push_back(static_cast<Z>(first[i]));
+    }
+    check_moduli<Z, R>(m, count);
+}
+
+// A width which is not a multiple of the limb size:
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<521, 521,
+    boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void> > uint521_t;
+
+int main()
+{
+    // Moduli of at most 2^(N-1), for Shoup's multiplication, and larger ones:
+    const boost::uint64_t small[] = { 251, 127, 128, 3 };
+    const boost::uint64_t bytes[] = { 255, 254, 253, 251 };
+    const boost::uint64_t ntt[] = { 2013265921, 469762049, 754974721, 167772161, 998244353, 1004535809, 7, 65537 };
+    const boost::uint64_t words[] = { 2147483647, 2147483629 };
+    const boost::uint64_t wide_words[] = { 4294967291u, 4294967279u, 3, 1000003 };
+    const boost::uint64_t longs[] = { 9223372036854775783ull, 4611686018427387847ull };
+    const boost::uint64_t wide_longs[] = { 18446744073709551557ull, 9223372036854775783ull, 12345 };
+    check_moduli<boost::uint8_t, boost::uint64_t>(small, 4);
+    check_moduli<boost::uint8_t, boost::uint64_t>(bytes, 4);
+    check_moduli<boost::uint32_t, cpp_int>(ntt, 8);
+    check_moduli<boost::uint32_t, boost::uint64_t>(words, 2);
+    check_moduli<boost::uint32_t, cpp_int>(wide_words, 4);
+#ifdef BOOST_HAS_INT128
+    check_moduli<boost::uint64_t, boost::uint128_type>(longs, 2);
+#endif
+    check_moduli<boost::uint64_t, boost::multiprecision::uint256_t>(wide_longs, 3);
+    check_moduli<boost::uint64_t, uint521_t>(ntt, 8);
+
+    // Moduli with common factors, repeated, and of one:
+    const boost::uint64_t common[] = { 12, 18, 30, 7, 35, 1, 12 };
+    const boost::uint64_t signed_common[] = { 9, 6, 4, 25 };
+    const boost::uint64_t large_common[] = { 600, 1000, 36, 1000000007, 6000000042ull };
+    const boost::uint64_t ones[] = { 1, 1 };
+    check_moduli<boost::uint32_t, boost::uint64_t>(common, 7);
+    check_moduli<boost::uint16_t, boost::uint32_t>(common, 7);
+    check_moduli<int, long long>(signed_common, 4);
+    check_moduli<boost::int64_t, cpp_int>(large_common, 5);
+    check_moduli<boost::uint64_t, cpp_int>(large_common, 5);
+    check_moduli<boost::uint32_t, boost::uint32_t>(ones, 2);
+    check_moduli<boost::uint32_t, boost::uint32_t>(ones, 0);
+
+    // More moduli than are kept on the stack, with every small common factor:
+    std::vector<boost::uint64_t> many;
+    for (boost::uint64_t i = 2; i < 42; ++i)
+    {
+        many.push_back(i * i + i / 3);
+    }
+    check_moduli<boost::uint32_t, cpp_int>(many.data(), many.size(), 20);
+
+    // Unbounded types:
+    std::vector<cpp_int> big;
+    big.push_back(cpp_int(1) << 100);
+    big.push_back((cpp_int(1) << 89) - 1);
+    big.push_back(12);
+    big.push_back(boost::multiprecision::pow(cpp_int(3), 40));
+    check_moduli<cpp_int, cpp_int>(big, 40);
+
+    const boost::uint32_t zero[] = { 7, 0 };
+    const int negative[] = { 7, -3 };
+    const boost::uint32_t overflow[] = { 65537, 65539 };
+    BOOST_TEST_THROWS((crt_basis<boost::uint32_t, boost::uint64_t>(zero, zero + 2)), std::domain_error);
+    BOOST_TEST_THROWS((crt_basis<int, long long>(negative, negative + 2)), std::domain_error);
+    BOOST_TEST_THROWS((crt_basis<boost::uint32_t>(overflow, overflow + 2)), std::overflow_error);
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
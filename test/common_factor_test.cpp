@@ -20,6 +20,7 @@
 #include <boost/config.hpp>              // for BOOST_MSVC, etc.
 #include <boost/detail/workaround.hpp>
 #include <boost/integer/common_factor.hpp>  // for boost::integer::gcd, etc.
+#include <boost/integer/integer_log2.hpp>  // for boost::integer_log2
 #include <boost/mpl/list.hpp>            // for boost::mpl::list
 #include <boost/operators.hpp>
 #include <boost/core/lightweight_test.hpp>
@@ -255,6 +256,22 @@ public:
 
 }  // namespace std
 
+// Have MyUnsigned2 opt in to run time algorithm selection, with crossover points low
+// enough that all three algorithms get used:
+namespace boost { namespace integer { namespace gcd_detail {
+
+template <>
+struct gcd_traits<MyUnsigned2> : public gcd_traits_defaults<MyUnsigned2>
+{
+   static const method_type method = method_adaptive;
+   static const int adaptive_binary_max_bits = 8;
+   static const int adaptive_euclid_min_bits = 25;
+   static const int adaptive_euclid_min_bit_difference = 12;
+   static int log2(const MyUnsigned2& val) { return boost::integer_log2(val.value()); }
+};
+
+}}}
+
 // GCD tests
 
 // GCD on signed integer types
@@ -391,7 +408,27 @@ void gcd_method_test()
       BOOST_TEST(v2 % g == 0);
       BOOST_TEST_EQ(g, boost::integer::gcd_detail::mixed_binary_gcd(v1, v2));
       BOOST_TEST_EQ(g, boost::integer::gcd_detail::Stein_gcd(v1, v2));
+      BOOST_TEST_EQ(g, boost::integer::gcd_detail::adaptive_gcd(v1, v2));
+   }
+}
+
+template <class T>
+void gcd_adaptive_test()
+{
+   // Operands of very different widths, of similar widths, and small operands:
+   boost::random::mt19937 gen;
+   boost::random::uniform_int_distribution<unsigned> shift(0, 30);
+   boost::random::uniform_int_distribution<unsigned> d(1, (std::numeric_limits<unsigned>::max)());
+
+   for (unsigned int i = 0; i < 10000; ++i)
+   {
+      T v1 = static_cast<T>(d(gen) >> shift(gen));
+      T v2 = static_cast<T>(d(gen) >> shift(gen));
+      T g = boost::integer::gcd_detail::Euclid_gcd(v1, v2);
+      BOOST_TEST_EQ(g, boost::integer::gcd_detail::adaptive_gcd(v1, v2));
    }
+   BOOST_TEST_EQ(boost::integer::gcd_detail::adaptive_gcd(T(0), T(12)), T(12));
+   BOOST_TEST_EQ(boost::integer::gcd_detail::adaptive_gcd(T(12), T(0)), T(12));
 }
 
 // LCM tests
@@ -620,6 +657,11 @@ int main()
    TEST_UNSIGNED(gcd_unsigned_test)
    gcd_static_test();
    gcd_method_test();
+   gcd_adaptive_test<MyUnsigned2>();
+   gcd_adaptive_test<unsigned>();
+#ifndef DISABLE_MP_TESTS
+   gcd_adaptive_test<boost::multiprecision::cpp_int>();
+#endif
 
    TEST_SIGNED(lcm_int_test)
    lcm_unmarked_int_test();
@@ -14,9 +14,25 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/integer/common_factor.hpp>
 
+// Route the long long types through the binary algorithm, so that both are tested via the public
+// interface:
+namespace boost { namespace integer { namespace euclidean_detail {
+template<>
+struct extended_euclidean_traits< boost::long_long_type >
+{
+    static const method_type method = method_binary;
+};
+template<>
+struct extended_euclidean_traits< boost::ulong_long_type >
+{
+    static const method_type method = method_binary;
+};
+}}}
+
 using boost::multiprecision::int128_t;
 using boost::multiprecision::int256_t;
 using boost::integer::extended_euclidean;
+using boost::integer::extended_euclidean_x;
 using boost::integer::gcd;
 
 template<class Z>
@@ -35,18 +51,198 @@ void test_extended_euclidean()
             int256_t y = u.y;
             BOOST_TEST_EQ(u.gcd, gcdmn);
             BOOST_TEST_EQ(m*x + n*y, gcdmn);
+            boost::integer::euclidean_x_result_t<Z> v = extended_euclidean_x(m, n);
+            BOOST_TEST_EQ(v.gcd, u.gcd);
+            BOOST_TEST_EQ(v.x, u.x);
         }
     }
 }
 
 
+// Interprets an unsigned cofactor as two's complement, which the bounds on the cofactors allow:
+template<class Z>
+int256_t signed_value(Z x)
+{
+    if (x > (std::numeric_limits<Z>::max)() / 2)
+    {
+        return -int256_t(static_cast<Z>(Z(0) - x));
+    }
+    return int256_t(x);
+}
+
+template<class Z>
+void check_unsigned(Z m, Z n)
+{
+    boost::integer::euclidean_result_t<Z> u = extended_euclidean(m, n);
+    Z gcdmn = gcd(m, n);
+    BOOST_TEST(u.gcd == gcdmn);
+    // Exact in wrapping arithmetic, and over the integers once the signs are restored:
+    BOOST_TEST(static_cast<Z>(m*u.x + n*u.y) == gcdmn);
+    int256_t x = signed_value(u.x);
+    int256_t y = signed_value(u.y);
+    BOOST_TEST_EQ(m*x + n*y, int256_t(gcdmn));
+    BOOST_TEST(abs(x) <= (std::max)(int256_t(1), int256_t(n / gcdmn) / 2));
+    BOOST_TEST(abs(y) <= (std::max)(int256_t(1), int256_t(m / gcdmn) / 2));
+    boost::integer::euclidean_x_result_t<Z> v = extended_euclidean_x(m, n);
+    BOOST_TEST(v.gcd == u.gcd);
+    BOOST_TEST(v.x == u.x);
+}
+
+template<class Z>
+void test_unsigned_extended_euclidean()
+{
+    Z max_arg = 300;
+    for (Z m = max_arg; m > 0; --m)
+    {
+        for (Z n = max_arg; n > 0; --n)
+        {
+            check_unsigned(m, n);
+        }
+    }
+    // Full range operands, which would overflow a signed type of the same width:
+    const Z top = (std::numeric_limits<Z>::max)();
+    for (Z i = 0; i < 50; ++i)
+    {
+        check_unsigned(static_cast<Z>(top - i), static_cast<Z>(top - 2*i - 1));
+        check_unsigned(static_cast<Z>(top - i), static_cast<Z>(i + 1));
+        check_unsigned(static_cast<Z>(top / 3 + i), static_cast<Z>(top - i));
+        check_unsigned(static_cast<Z>(top - i), static_cast<Z>(top - i));
+    }
+    // Fibonacci neighbours take the most steps:
+    Z a = 1, b = 1;
+    while (b <= top - a)
+    {
+        Z c = static_cast<Z>(a + b);
+        a = b;
+        b = c;
+    }
+    check_unsigned(b, a);
+    check_unsigned(a, b);
+}
+
+template<class Z>
+void check_binary(Z m, Z n)
+{
+    using namespace boost::integer::euclidean_detail;
+    unsigned_euclidean_result_t<Z> d = division_unsigned_extended_euclidean<true>(m, n);
+    unsigned_euclidean_result_t<Z> b = binary_unsigned_extended_euclidean<true>(m, n);
+    // Both find the minimal cofactors, which are unique apart from the ties |x| = n/2g, |y| = m/2g:
+    BOOST_TEST(b.gcd == d.gcd);
+    Z g = d.gcd;
+    if (d.x != static_cast<Z>(n / g / 2) && d.y != static_cast<Z>(m / g / 2))
+    {
+        BOOST_TEST(b.x == d.x);
+        BOOST_TEST(b.y == d.y);
+        BOOST_TEST(b.x_negative == d.x_negative || (d.x == Z(0) || d.y == Z(0)));
+    }
+}
+
+template<class Z>
+void test_binary_extended_euclidean()
+{
+    for (Z m = 1; m < 200; ++m)
+    {
+        for (Z n = 1; n < 200; ++n)
+        {
+            check_binary(m, n);
+        }
+    }
+    const Z top = (std::numeric_limits<Z>::max)();
+    for (Z i = 0; i < 50; ++i)
+    {
+        check_binary(static_cast<Z>(top - i), static_cast<Z>(top - 2*i - 1));
+        check_binary(static_cast<Z>(top - i), static_cast<Z>(i + 1));
+        check_binary(static_cast<Z>(top / 3 + i), static_cast<Z>(top - i));
+        // A large common power of two:
+        const int k = std::numeric_limits<Z>::digits / 4;
+        check_binary(static_cast<Z>((top >> (2 * k)) << k), static_cast<Z>(((top >> (2 * k)) - i) << (k + 2)));
+    }
+}
+
+// Large operands built from powers of small numbers, for which Lehmer's algorithm does most of its
+// steps on the leading words:
+void test_lehmer_extended_euclidean()
+{
+    using namespace boost::integer::euclidean_detail;
+    using boost::multiprecision::cpp_int;
+    cpp_int a = 1;
+    cpp_int b = 1;
+    for (int i = 1; i < 1200; ++i)
+    {
+        a *= 3;
+        b *= 7;
+        cpp_int m = a + i;
+        cpp_int n = (b >> (i % 64)) + 1;
+        cpp_int common = (cpp_int(1) << (i % 200)) * (i % 5 + 1);
+        for (int j = 0; j < 2; ++j)
+        {
+            unsigned_euclidean_result_t<cpp_int> d = division_unsigned_extended_euclidean<true>(m, n);
+            unsigned_euclidean_result_t<cpp_int> l = lehmer_unsigned_extended_euclidean<true>(m, n);
+            BOOST_TEST_EQ(l.gcd, d.gcd);
+            BOOST_TEST_EQ(l.x, d.x);
+            BOOST_TEST_EQ(l.y, d.y);
+            BOOST_TEST_EQ(l.x_negative, d.x_negative);
+            boost::integer::euclidean_result_t<cpp_int> u = extended_euclidean(m, n);
+            BOOST_TEST_EQ(u.gcd, gcd(m, n));
+            BOOST_TEST_EQ(m*u.x + n*u.y, u.gcd);
+            BOOST_TEST_EQ(extended_euclidean_x(m, n).x, u.x);
+            m *= common;
+            n *= common;
+        }
+    }
+}
+
+// Reusing one workspace and result across calls must not change the results:
+template<class Z>
+void test_extended_euclidean_workspace()
+{
+    boost::integer::extended_euclidean_workspace<Z> workspace;
+    boost::integer::euclidean_result_t<Z> result;
+    Z m = 1;
+    for (int i = 1; i < 300; ++i)
+    {
+        m = m * 5 + i;
+        Z n = (m >> (i % 37)) * 3 + i;
+        BOOST_TEST(boost::integer::extended_euclidean(m, n, result, workspace));
+        boost::integer::euclidean_result_t<Z> expected = extended_euclidean(m, n);
+        BOOST_TEST_EQ(result.gcd, expected.gcd);
+        BOOST_TEST_EQ(result.x, expected.x);
+        BOOST_TEST_EQ(result.y, expected.y);
+        if (i > 20 && std::numeric_limits<Z>::is_bounded)
+        {
+            m = m % 1000003;
+        }
+    }
+    BOOST_TEST(!boost::integer::extended_euclidean(Z(0), Z(3), result, workspace));
+    BOOST_TEST_EQ(result.gcd, Z(0));
+}
 
 int main()
 {
     test_extended_euclidean<boost::int16_t>();
     test_extended_euclidean<boost::int32_t>();
     test_extended_euclidean<boost::int64_t>();
+    test_extended_euclidean<boost::long_long_type>();
     test_extended_euclidean<int128_t>();
+    test_lehmer_extended_euclidean();
+    test_extended_euclidean_workspace<boost::multiprecision::cpp_int>();
+    test_extended_euclidean_workspace<boost::int64_t>();
+
+    test_unsigned_extended_euclidean<boost::uint16_t>();
+    test_unsigned_extended_euclidean<boost::uint32_t>();
+    test_unsigned_extended_euclidean<boost::uint64_t>();
+    test_unsigned_extended_euclidean<boost::ulong_long_type>();
+    test_unsigned_extended_euclidean<boost::multiprecision::uint128_t>();
+#ifdef BOOST_HAS_INT128
+    test_unsigned_extended_euclidean<boost::uint128_type>();
+#endif
+
+    test_binary_extended_euclidean<boost::uint16_t>();
+    test_binary_extended_euclidean<boost::uint32_t>();
+    test_binary_extended_euclidean<boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_binary_extended_euclidean<boost::uint128_type>();
+#endif
 
     return boost::report_errors();;
 }
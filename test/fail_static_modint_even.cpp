@@ -0,0 +1,16 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/integer/static_modint.hpp>
+#include <iostream>
+
+int main()
+{
+    // Montgomery's method needs an odd modulus:
+    boost::integer::static_modint<1000000000u, true> x(3);
+    std::cout << (x * x).value();
+    return 0;
+}
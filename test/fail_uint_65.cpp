@@ -8,6 +8,11 @@
 
 int main()
 {
+#ifdef BOOST_INTEGER_HAS_BITINT
+ // _BitInt supplies the wider types, so go beyond the widest of those instead:
+ std::cout << sizeof(boost::uint_t<BOOST_INTEGER_BITINT_MAXWIDTH + 1>::least);
+#else
  std::cout << std::numeric_limits<boost::uint_t<65>::least>::digits;
+#endif
  return 0;
 }
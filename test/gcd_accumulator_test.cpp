@@ -0,0 +1,179 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/gcd_accumulator.hpp>
+#include <boost/integer/common_factor.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using boost::integer::gcd_accumulator;
+using boost::integer::lcm_accumulator;
+
+template <class T>
+void test_gcd_accumulator()
+{
+   gcd_accumulator<T> acc;
+   BOOST_TEST_EQ(acc.value(), T(0));
+   BOOST_TEST(!acc.saturated());
+
+   acc.push(T(84));
+   BOOST_TEST_EQ(acc.value(), T(84));
+   acc.push(T(126));
+   BOOST_TEST_EQ(acc.value(), T(42));
+   acc.push(T(0));
+   BOOST_TEST_EQ(acc.value(), T(42));
+
+   // Batches agree with gcd_range, including the termination position:
+   T data[] = { 210, 330, 462, 770, 1155, 7, 13, 26 };
+   const std::size_t n = sizeof(data) / sizeof(data[0]);
+   gcd_accumulator<T> batch;
+   const T* stop = batch.push_batch(data, n);
+   std::pair<T, T*> r = boost::integer::gcd_range(data, data + n);
+   BOOST_TEST_EQ(batch.value(), r.first);
+   BOOST_TEST(stop == r.second);
+   BOOST_TEST(batch.saturated());
+
+   // Saturated accumulators ignore further input:
+   batch.push(T(10));
+   BOOST_TEST_EQ(batch.value(), T(1));
+
+   // Splitting the input between several accumulators and merging gives the same answer
+   // whatever the split point:
+   T values[] = { 360, 840, 1260, 2520, 600 };
+   const std::size_t m = sizeof(values) / sizeof(values[0]);
+   for (std::size_t split = 0; split <= m; ++split)
+   {
+      gcd_accumulator<T> left, right;
+      left.push_batch(values, values + split);
+      right.push_batch(values + split, values + m);
+      left.merge(right);
+      BOOST_TEST_EQ(left.value(), T(60));
+   }
+
+   acc.reset();
+   BOOST_TEST_EQ(acc.value(), T(0));
+}
+
+template <class T>
+void test_lcm_accumulator()
+{
+   lcm_accumulator<T> acc;
+   BOOST_TEST_EQ(acc.value(), T(1));
+   BOOST_TEST(!acc.saturated());
+
+   acc.push(T(4));
+   acc.push(T(6));
+   BOOST_TEST_EQ(acc.value(), T(12));
+
+   T data[] = { 2, 3, 4, 5, 0, 7 };
+   const std::size_t n = sizeof(data) / sizeof(data[0]);
+   lcm_accumulator<T> batch;
+   const T* stop = batch.push_batch(data, n);
+   std::pair<T, T*> r = boost::integer::lcm_range(data, data + n);
+   BOOST_TEST_EQ(batch.value(), r.first);
+   BOOST_TEST(stop == r.second);
+   BOOST_TEST(batch.saturated());
+
+   std::vector<T> values;
+   for (T i = 1; i <= 10; ++i)
+      values.push_back(i);
+   lcm_accumulator<T> left, right;
+   left.push_batch(values.begin(), values.begin() + 4);
+   right.push_batch(values.begin() + 4, values.end());
+   left.merge(right);
+   BOOST_TEST_EQ(left.value(), T(2520));
+
+   acc.reset();
+   BOOST_TEST_EQ(acc.value(), T(1));
+}
+
+void test_signed()
+{
+   gcd_accumulator<int> g(-12);
+   BOOST_TEST_EQ(g.value(), 12);
+   g.push(-18);
+   BOOST_TEST_EQ(g.value(), 6);
+
+   lcm_accumulator<int> l;
+   l.push(-4);
+   l.push(6);
+   BOOST_TEST_EQ(l.value(), 12);
+}
+
+// The magnitude of the minimum does not fit, and is held as the minimum itself, as gcd returns it:
+template <class T>
+void test_minimum()
+{
+   const T min_value = (std::numeric_limits<T>::min)();
+   gcd_accumulator<T> g;
+   g.push(min_value);
+   BOOST_TEST_EQ(g.value(), min_value);
+   g.push(min_value);
+   BOOST_TEST_EQ(g.value(), min_value);
+   g.push(T(0));
+   BOOST_TEST_EQ(g.value(), min_value);
+   g.push(T(-24));
+   BOOST_TEST_EQ(g.value(), T(8));
+   g.push(min_value);
+   BOOST_TEST_EQ(g.value(), T(8));
+
+   gcd_accumulator<T> from_min(min_value);
+   BOOST_TEST_EQ(from_min.value(), min_value);
+   from_min.push(T(0));
+   BOOST_TEST_EQ(from_min.value(), min_value);
+   gcd_accumulator<T> other(T(12));
+   from_min.merge(other);
+   BOOST_TEST_EQ(from_min.value(), T(4));
+   gcd_accumulator<T> merged;
+   merged.merge(gcd_accumulator<T>(min_value));
+   BOOST_TEST_EQ(merged.value(), min_value);
+   T data[] = { 0, min_value, 0, min_value, 6 };
+   gcd_accumulator<T> batch;
+   batch.push_batch(data, data + 5);
+   BOOST_TEST_EQ(batch.value(), T(2));
+
+   lcm_accumulator<T> l(min_value);
+   BOOST_TEST_EQ(l.value(), min_value);
+   l.push(T(-2));
+   l.push(min_value);
+   BOOST_TEST_EQ(l.value(), min_value);
+   lcm_accumulator<T> l2;
+   l2.push(T(4));
+   l2.push(min_value);
+   BOOST_TEST_EQ(l2.value(), min_value);
+   l2.push(T(0));
+   BOOST_TEST_EQ(l2.value(), T(0));
+}
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+constexpr int constexpr_gcd_of_three(int a, int b, int c)
+{
+   gcd_accumulator<int> acc;
+   acc.push(a);
+   acc.push(b);
+   acc.push(c);
+   return acc.value();
+}
+static_assert(constexpr_gcd_of_three(12, 18, 27) == 3, "Expected constexpr gcd_accumulator.");
+static_assert(constexpr_gcd_of_three(0, (std::numeric_limits<int>::min)(), 0) == (std::numeric_limits<int>::min)(), "Expected constexpr gcd_accumulator.");
+#endif
+
+int main()
+{
+   test_gcd_accumulator<int>();
+   test_gcd_accumulator<unsigned>();
+   test_gcd_accumulator<boost::int64_t>();
+   test_gcd_accumulator<boost::uint64_t>();
+   test_lcm_accumulator<int>();
+   test_lcm_accumulator<unsigned long>();
+   test_signed();
+   test_minimum<signed char>();
+   test_minimum<int>();
+   test_minimum<boost::int64_t>();
+
+   return boost::report_errors();
+}
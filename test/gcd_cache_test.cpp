@@ -0,0 +1,131 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/gcd_cache.hpp>
+#include <boost/integer/common_factor.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+using boost::integer::gcd_cache;
+using boost::integer::gcd_cache_statistics;
+
+template <class T>
+void test_basic()
+{
+   gcd_cache<T> cache(64, 4);
+   BOOST_TEST_EQ(cache.capacity(), 64u);
+   BOOST_TEST_EQ(cache.shard_count(), 4u);
+
+   BOOST_TEST_EQ(cache(T(84), T(126)), T(42));
+   gcd_cache_statistics s = cache.statistics();
+   BOOST_TEST_EQ(s.hits, 0u);
+   BOOST_TEST_EQ(s.misses, 1u);
+
+   // Same pair, swapped pair: both served from the cache.
+   BOOST_TEST_EQ(cache(T(84), T(126)), T(42));
+   BOOST_TEST_EQ(cache(T(126), T(84)), T(42));
+   s = cache.statistics();
+   BOOST_TEST_EQ(s.hits, 2u);
+   BOOST_TEST_EQ(s.misses, 1u);
+
+   // Per-shard statistics add up to the totals:
+   gcd_cache_statistics sum = { 0, 0, 0 };
+   for (std::size_t i = 0; i < cache.shard_count(); ++i)
+   {
+      sum.hits += cache.statistics(i).hits;
+      sum.misses += cache.statistics(i).misses;
+   }
+   BOOST_TEST_EQ(sum.hits, s.hits);
+   BOOST_TEST_EQ(sum.misses, s.misses);
+
+   // Far more distinct pairs than slots: results stay correct and memory stays bounded.
+   for (int i = 1; i < 500; ++i)
+      BOOST_TEST_EQ(cache(T(i * 6), T(i * 10)), boost::integer::gcd(T(i * 6), T(i * 10)));
+   s = cache.statistics();
+   BOOST_TEST(s.evictions > 0u);
+   BOOST_TEST_EQ(cache.capacity(), 64u);
+
+   cache.clear();
+   s = cache.statistics();
+   BOOST_TEST_EQ(s.hits + s.misses + s.evictions, 0u);
+}
+
+void test_signed()
+{
+   gcd_cache<int> cache(16);
+   BOOST_TEST_EQ(cache(-12, 18), 6);
+   BOOST_TEST_EQ(cache(18, 12), 6);
+   BOOST_TEST_EQ(cache.statistics().hits, 1u);
+}
+
+// The minimum has no magnitude in its own type, and is held as itself, as gcd returns it:
+template <class T>
+void test_minimum()
+{
+   const T m = (std::numeric_limits<T>::min)();
+   gcd_cache<T> cache(16);
+   BOOST_TEST_EQ(cache(m, T(12)), T(4));
+   BOOST_TEST_EQ(cache(T(-12), m), T(4));
+   BOOST_TEST_EQ(cache(m, T(0)), m);
+   BOOST_TEST_EQ(cache(T(0), m), m);
+   BOOST_TEST_EQ(cache(m, m), m);
+   BOOST_TEST_EQ(cache(m, m), m);
+   BOOST_TEST_EQ(cache(m, T(3)), T(1));
+   BOOST_TEST_EQ(cache(m, T(-(std::numeric_limits<T>::max)())), T(1));
+   BOOST_TEST_EQ(cache.statistics().hits, 3u);
+}
+
+void test_threads()
+{
+   gcd_cache<boost::uint64_t> cache(1024, 8);
+   const int thread_count = 4;
+   std::vector<int> failures(thread_count, 0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < thread_count; ++t)
+   {
+      threads.push_back(std::thread([&cache, &failures, t]()
+      {
+         for (int round = 0; round < 20; ++round)
+         {
+            for (boost::uint64_t i = 1; i < 200; ++i)
+            {
+               boost::uint64_t a = i * 2 * 3 * 5, b = i * 7 * 3;
+               if (cache(a, b) != boost::integer::gcd(a, b))
+                  ++failures[t];
+            }
+         }
+      }));
+   }
+   for (std::size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+   for (int t = 0; t < thread_count; ++t)
+      BOOST_TEST_EQ(failures[t], 0);
+   gcd_cache_statistics s = cache.statistics();
+   BOOST_TEST_EQ(s.hits + s.misses, static_cast<boost::uintmax_t>(thread_count * 20 * 199));
+   BOOST_TEST(s.hits > s.misses);
+}
+
+int main()
+{
+   test_basic<int>();
+   test_basic<boost::uint64_t>();
+#ifndef DISABLE_MP_TESTS
+   test_basic<boost::multiprecision::cpp_int>();
+#endif
+   test_signed();
+   test_minimum<int>();
+   test_minimum<boost::int64_t>();
+   test_threads();
+
+   return boost::report_errors();
+}
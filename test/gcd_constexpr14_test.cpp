@@ -61,6 +61,21 @@ void test_constexpr5()
 
    static_assert(k == 347, "Expected result not integer in constexpr gcd.");
 }
+
+void test_constexpr6()
+{
+   constexpr const boost::uint64_t i = 347 * 463 * 727;
+   constexpr const boost::uint64_t j = 191 * 347 * 281;
+
+   constexpr const boost::uint64_t k = boost::integer::gcd_evaluator<boost::uint64_t>()(i, j);
+   constexpr const boost::uint64_t l = boost::integer::lcm_evaluator<>()(i, j);
+   constexpr const boost::uint64_t m = boost::integer::gcd_evaluator<>()(boost::integer::gcd_evaluator<>::identity<boost::uint64_t>(), i);
+
+   static_assert(k == 347, "Expected result not integer in constexpr gcd_evaluator.");
+   static_assert(l == 6268802158037, "Expected result not integer in constexpr lcm_evaluator.");
+   static_assert(m == i, "Expected identity element in constexpr gcd_evaluator.");
+   static_assert(boost::integer::lcm_evaluator<int>::identity() == 1, "Expected identity element in constexpr lcm_evaluator.");
+}
 #endif
 
 
@@ -0,0 +1,119 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/common_factor.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+#include <execution>
+#endif
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+using boost::integer::gcd_evaluator;
+using boost::integer::lcm_evaluator;
+
+void test_transparent()
+{
+   gcd_evaluator<> g;
+   lcm_evaluator<> l;
+   BOOST_TEST_EQ(g(12, 18), 6);
+   BOOST_TEST_EQ(g(-12, 18L), 6L);
+   BOOST_TEST_EQ(g(12u, 18), 6u);
+   BOOST_TEST_EQ(l(4, 6), 12);
+   BOOST_TEST_EQ(l(static_cast<short>(-4), 6L), 12L);
+   // Mixed signedness with an unsigned common type: negative arguments count by their magnitude.
+   BOOST_TEST_EQ(g(-12, 18u), 6u);
+   BOOST_TEST_EQ(g(18u, -12), 6u);
+   BOOST_TEST_EQ(g(-7, 0u), 7u);
+   BOOST_TEST_EQ(g((std::numeric_limits<int>::min)(), 0u), 2147483648u);
+   BOOST_TEST_EQ(g(-12LL, 18ULL), 6ULL);
+   BOOST_TEST_EQ(l(-4, 6u), 12u);
+   BOOST_TEST_EQ(l(6u, static_cast<signed char>(-4)), 12u);
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+   static_assert(gcd_evaluator<>()(-12, 18u) == 6u, "Expected result not correct in constexpr gcd_evaluator<>.");
+   static_assert(lcm_evaluator<>()(-4, 6u) == 12u, "Expected result not correct in constexpr lcm_evaluator<>.");
+#endif
+   BOOST_TEST_EQ(g.identity<int>(), 0);
+   BOOST_TEST_EQ(l.identity<int>(), 1);
+   BOOST_TEST_EQ(gcd_evaluator<unsigned>::identity(), 0u);
+   BOOST_TEST_EQ(lcm_evaluator<unsigned>::identity(), 1u);
+}
+
+//
+// Reductions with the identity as initial value agree with gcd_range/lcm_range for
+// nonnegative inputs, whatever order the algorithm combines the elements in:
+//
+template <class T>
+void test_reduce(const std::vector<T>& v)
+{
+   T expected_gcd = boost::integer::gcd_range(v.begin(), v.end()).first;
+
+   BOOST_TEST_EQ(std::accumulate(v.begin(), v.end(), gcd_evaluator<T>::identity(), gcd_evaluator<T>()), expected_gcd);
+   BOOST_TEST_EQ(std::accumulate(v.begin(), v.end(), gcd_evaluator<>::identity<T>(), gcd_evaluator<>()), expected_gcd);
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+   BOOST_TEST_EQ(std::reduce(std::execution::seq, v.begin(), v.end(), gcd_evaluator<T>::identity(), gcd_evaluator<T>()), expected_gcd);
+   BOOST_TEST_EQ(std::reduce(std::execution::par, v.begin(), v.end(), gcd_evaluator<>::identity<T>(), gcd_evaluator<>()), expected_gcd);
+   BOOST_TEST_EQ(std::reduce(std::execution::par_unseq, v.begin(), v.end(), gcd_evaluator<T>::identity(), gcd_evaluator<T>()), expected_gcd);
+   BOOST_TEST_EQ(std::reduce(std::execution::unseq, v.begin(), v.end(), gcd_evaluator<>::identity<T>(), gcd_evaluator<>()), expected_gcd);
+#endif
+}
+
+template <class T>
+void test_reduce_lcm(const std::vector<T>& v)
+{
+   T expected_lcm = boost::integer::lcm_range(v.begin(), v.end()).first;
+
+   BOOST_TEST_EQ(std::accumulate(v.begin(), v.end(), lcm_evaluator<T>::identity(), lcm_evaluator<T>()), expected_lcm);
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+   BOOST_TEST_EQ(std::reduce(std::execution::par, v.begin(), v.end(), lcm_evaluator<>::identity<T>(), lcm_evaluator<>()), expected_lcm);
+   BOOST_TEST_EQ(std::reduce(std::execution::par_unseq, v.begin(), v.end(), lcm_evaluator<T>::identity(), lcm_evaluator<T>()), expected_lcm);
+#endif
+}
+
+template <class T>
+void test_type()
+{
+   std::mt19937 gen(1234);
+   std::uniform_int_distribution<int> dist(1, 1000);
+   for (int n = 1; n < 2000; n = n * 3 + 1)
+   {
+      // Multiples of a common factor, so the gcd is not always 1:
+      std::vector<T> v;
+      for (int i = 0; i < n; ++i)
+         v.push_back(static_cast<T>(T(dist(gen)) * T(30)));
+      test_reduce(v);
+      v.push_back(T(0));
+      test_reduce(v);
+   }
+   std::vector<T> small;
+   for (int i = 1; i <= 12; ++i)
+      small.push_back(T(i));
+   test_reduce_lcm(small);
+   small.push_back(T(0));
+   test_reduce_lcm(small);
+}
+
+int main()
+{
+   test_transparent();
+   test_type<int>();
+   test_type<unsigned>();
+   test_type<boost::int64_t>();
+   test_type<boost::uint64_t>();
+#ifndef DISABLE_MP_TESTS
+   test_type<boost::multiprecision::cpp_int>();
+#endif
+
+   return boost::report_errors();
+}
@@ -0,0 +1,97 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_INTEGER_GCD_INSTRUMENTATION boost::integer::gcd_histogram_instrumentation
+#include <boost/integer/gcd_instrumentation.hpp>
+#include <boost/integer/common_factor.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using boost::integer::gcd_histogram_instrumentation;
+using boost::integer::gcd_histograms;
+using namespace boost::integer::gcd_detail;
+
+void test_counts()
+{
+   gcd_histogram_instrumentation::reset_thread();
+
+   // 12 % 18, 18 % 12, 12 % 6:
+   BOOST_TEST_EQ(Euclid_gcd(12u, 18u), 6u);
+   // 12 and 18 lose 2 + 1 bits, then 9 - 3 = 6 loses one more:
+   BOOST_TEST_EQ(Stein_gcd(12u, 18u), 6u);
+   // 18 and 12 lose 1 + 2 bits, then 9 % 3 finishes:
+   BOOST_TEST_EQ(mixed_binary_gcd(12u, 18u), 6u);
+
+   gcd_histograms h = gcd_histogram_instrumentation::thread_histograms();
+   BOOST_TEST_EQ(h.method[method_euclid].calls, 1u);
+   BOOST_TEST_EQ(h.method[method_euclid].iterations.total, 3u);
+   BOOST_TEST_EQ(h.method[method_euclid].modulos.total, 3u);
+   BOOST_TEST_EQ(h.method[method_euclid].shifts.total, 0u);
+   BOOST_TEST_EQ(h.method[method_euclid].iterations.buckets[2], 1u);  // 3 is in [2, 4)
+   BOOST_TEST_EQ(h.method[method_euclid].shifts.buckets[0], 1u);
+
+   BOOST_TEST_EQ(h.method[method_binary].calls, 1u);
+   BOOST_TEST_EQ(h.method[method_binary].iterations.total, 1u);
+   BOOST_TEST_EQ(h.method[method_binary].modulos.total, 0u);
+   BOOST_TEST_EQ(h.method[method_binary].shifts.total, 4u);
+
+   BOOST_TEST_EQ(h.method[method_mixed].calls, 1u);
+   BOOST_TEST_EQ(h.method[method_mixed].iterations.total, 1u);
+   BOOST_TEST_EQ(h.method[method_mixed].modulos.total, 1u);
+   BOOST_TEST_EQ(h.method[method_mixed].shifts.total, 3u);
+   BOOST_TEST_EQ(h.method[method_mixed].shifts.max, 3u);
+
+   // The public interface is instrumented too:
+   for (unsigned i = 1; i <= 100; ++i)
+      boost::integer::gcd(i * 6, i * 10);
+   h = gcd_histogram_instrumentation::thread_histograms();
+   BOOST_TEST_EQ(h.method[method_mixed].calls, 101u);
+
+   std::ostringstream ss;
+   gcd_histogram_instrumentation::dump(ss, h);
+   BOOST_TEST(ss.str().find("mixed calls 101") != std::string::npos);
+   BOOST_TEST(ss.str().find("euclid iterations total 3") != std::string::npos);
+
+   gcd_histogram_instrumentation::reset_thread();
+   h = gcd_histogram_instrumentation::thread_histograms();
+   BOOST_TEST_EQ(h.method[method_mixed].calls, 0u);
+}
+
+void test_threads()
+{
+   gcd_histogram_instrumentation::reset();
+   const int thread_count = 4;
+   std::thread threads[thread_count];
+   for (int t = 0; t < thread_count; ++t)
+   {
+      threads[t] = std::thread([]()
+      {
+         for (int i = 1; i <= 50; ++i)
+            Euclid_gcd(i * 3, 1000);
+         // Each thread sees only its own calls:
+         BOOST_TEST_EQ(gcd_histogram_instrumentation::thread_histograms().method[method_euclid].calls, 50u);
+      });
+   }
+   for (int t = 0; t < thread_count; ++t)
+      threads[t].join();
+
+   // Exited threads are still accounted for:
+   gcd_histograms h = gcd_histogram_instrumentation::histograms();
+   BOOST_TEST_EQ(h.method[method_euclid].calls, static_cast<boost::uintmax_t>(thread_count * 50));
+   BOOST_TEST_EQ(h.method[method_euclid].iterations.total, h.method[method_euclid].modulos.total);
+
+   std::ostringstream ss;
+   gcd_histogram_instrumentation::dump(ss);
+   BOOST_TEST(ss.str().find("euclid calls 200") != std::string::npos);
+}
+
+int main()
+{
+   test_counts();
+   test_threads();
+
+   return boost::report_errors();
+}
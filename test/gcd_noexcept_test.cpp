@@ -28,6 +28,10 @@ void test_noexcept(unsigned char a, unsigned char b)
    static_assert(noexcept(boost::integer::gcd(static_cast<unsigned long>(a), static_cast<unsigned long>(b))), "Expected a noexcept function.");
    static_assert(noexcept(boost::integer::gcd(static_cast<long long>(a), static_cast<long long>(b))), "Expected a noexcept function.");
    static_assert(noexcept(boost::integer::gcd(static_cast<unsigned long long>(a), static_cast<unsigned long long>(b))), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::gcd_evaluator<int>()(static_cast<int>(a), static_cast<int>(b))), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::lcm_evaluator<long>()(static_cast<long>(a), static_cast<long>(b))), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::gcd_evaluator<>()(a, static_cast<unsigned>(b))), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::lcm_evaluator<>()(static_cast<short>(a), b)), "Expected a noexcept function.");
 }
 
 #endif
@@ -0,0 +1,132 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Tuned algorithm choices, as generated by tools/gcd_autotune.cpp, must be picked up by gcd_traits:
+//
+#include <boost/integer/detail/gcd_tuning.hpp>
+
+namespace boost { namespace integer { namespace gcd_detail {
+
+template <>
+struct gcd_tuning<unsigned short>
+{
+   static const bool is_tuned = true;
+   static const method_type method = method_binary;
+   static const int adaptive_binary_max_bits = 0;
+   static const int adaptive_euclid_min_bits = 17;
+   static const int adaptive_euclid_min_bit_difference = 17;
+};
+
+template <>
+struct gcd_tuning<unsigned>
+{
+   static const bool is_tuned = true;
+   static const method_type method = method_adaptive;
+   static const int adaptive_binary_max_bits = 8;
+   static const int adaptive_euclid_min_bits = 28;
+   static const int adaptive_euclid_min_bit_difference = 12;
+};
+
+// Signed types, and one which uses the generic bit scan:
+template <>
+struct gcd_tuning<long>
+{
+   static const bool is_tuned = true;
+   static const method_type method = method_adaptive;
+   static const int adaptive_binary_max_bits = 16;
+   static const int adaptive_euclid_min_bits = 40;
+   static const int adaptive_euclid_min_bit_difference = 20;
+};
+
+template <>
+struct gcd_tuning<signed char>
+{
+   static const bool is_tuned = true;
+   static const method_type method = method_adaptive;
+   static const int adaptive_binary_max_bits = 3;
+   static const int adaptive_euclid_min_bits = 6;
+   static const int adaptive_euclid_min_bit_difference = 3;
+};
+
+}}}
+
+#include <boost/integer/common_factor.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/integer/integer_log2.hpp>
+#include <limits>
+
+using boost::integer::gcd_detail::gcd_traits;
+
+BOOST_STATIC_ASSERT(gcd_traits<unsigned short>::method == boost::integer::gcd_detail::method_binary);
+BOOST_STATIC_ASSERT(gcd_traits<unsigned>::method == boost::integer::gcd_detail::method_adaptive);
+BOOST_STATIC_ASSERT(gcd_traits<unsigned>::adaptive_euclid_min_bits == 28);
+BOOST_STATIC_ASSERT(gcd_traits<long>::method == boost::integer::gcd_detail::method_adaptive);
+// Untuned types keep the defaults:
+BOOST_STATIC_ASSERT(gcd_traits<int>::method == boost::integer::gcd_detail::method_mixed);
+
+template <class T>
+void test_tuned()
+{
+   for (T a = 1; a < 300; a += 7)
+   {
+      for (T b = 0; b < 3000; b += 13)
+      {
+         BOOST_TEST_EQ(boost::integer::gcd(a, b), boost::integer::gcd_detail::Euclid_gcd(a, b));
+         BOOST_TEST_EQ(boost::integer::gcd(T(a << 4), T(b * 5)), boost::integer::gcd_detail::Euclid_gcd(T(a << 4), T(b * 5)));
+      }
+   }
+   BOOST_TEST_EQ(boost::integer::lcm(T(4), T(6)), T(12));
+}
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+// The adaptive method is usable in constant expressions, whichever algorithm it picks:
+static_assert(boost::integer::gcd(12u, 18u) == 6u, "Expected result not correct in constexpr adaptive gcd.");
+static_assert(boost::integer::gcd(3u << 20, 9u) == 3u, "Expected result not correct in constexpr adaptive gcd.");
+static_assert(boost::integer::gcd(0xF0000000u, 0xC0000000u) == 0x30000000u, "Expected result not correct in constexpr adaptive gcd.");
+static_assert(boost::integer::gcd(-12L, 18L) == 6L, "Expected result not correct in constexpr adaptive gcd.");
+static_assert(boost::integer::lcm(4L << 40, 6L) == 12L << 40, "Expected result not correct in constexpr adaptive lcm.");
+static_assert(boost::integer::gcd(static_cast<signed char>(-96), static_cast<signed char>(40)) == 8, "Expected result not correct in constexpr adaptive gcd.");
+static_assert(boost::integer::gcd_detail::gcd_traits<signed char>::log2(127) == 6, "Expected result not correct in constexpr log2.");
+static_assert(boost::integer::gcd_detail::gcd_traits<unsigned>::log2(1u) == 0, "Expected result not correct in constexpr log2.");
+#endif
+
+template <class T>
+void test_log2()
+{
+   for (T x = 1; x <= (std::numeric_limits<T>::max)() / 3; x = T(x * 3))
+   {
+      BOOST_TEST_EQ(gcd_traits<T>::log2(x), boost::integer_log2(x));
+      BOOST_TEST_EQ(gcd_traits<T>::log2(T(x + 1)), boost::integer_log2(T(x + 1)));
+   }
+   BOOST_TEST_EQ(gcd_traits<T>::log2((std::numeric_limits<T>::max)()), std::numeric_limits<T>::digits - 1);
+}
+
+int main()
+{
+   test_log2<signed char>();
+   test_log2<short>();
+   test_log2<unsigned short>();
+   test_log2<unsigned>();
+   test_log2<long>();
+   test_log2<boost::ulong_long_type>();
+#ifdef BOOST_HAS_INT128
+   BOOST_TEST_EQ(gcd_traits<boost::uint128_type>::log2(static_cast<boost::uint128_type>(5) << 100), 102);
+   BOOST_TEST_EQ(gcd_traits<boost::int128_type>::log2(static_cast<boost::int128_type>(1)), 0);
+#endif
+   for (int a = -127; a < 128; ++a)
+   {
+      for (int b = -127; b < 128; b += 3)
+      {
+         BOOST_TEST_EQ(static_cast<int>(boost::integer::gcd(static_cast<signed char>(a), static_cast<signed char>(b))), boost::integer::gcd(a, b));
+      }
+   }
+   test_tuned<long>();
+   test_tuned<unsigned short>();
+   test_tuned<unsigned>();
+   BOOST_TEST_EQ(boost::integer::gcd(3000000000u, 1000000000u), 1000000000u);
+
+   return boost::report_errors();
+}
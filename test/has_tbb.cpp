@@ -0,0 +1,13 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+// libstdc++ runs the parallel algorithms of <execution> on TBB when its headers are found,
+// in which case the program must also link against libtbb.
+
+#include <tbb/version.h>
+#include <utility>
+
+#if !defined(__GLIBCXX__)
+#error "Only libstdc++ uses TBB as the <execution> backend"
+#endif
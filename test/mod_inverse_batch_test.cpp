@@ -0,0 +1,79 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/integer/mod_inverse_batch.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+
+using boost::integer::mod_inverse;
+using boost::integer::mod_inverse_batch;
+
+template<class T>
+void check_batch(const std::vector<T>& a, const std::vector<T>& m)
+{
+    std::vector<T> out(a.size(), T(7));
+    bool* invertible = new bool[a.size() + 1];
+    std::size_t failures = mod_inverse_batch(a.data(), m.data(), out.data(), a.size(), invertible);
+    std::size_t expected_failures = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        T expected = T(0);
+        bool ok = m[i] >= T(2) && mod_inverse(a[i], m[i], expected);
+        expected_failures += !ok;
+        BOOST_TEST_EQ(out[i], expected);
+        BOOST_TEST_EQ(invertible[i], ok);
+    }
+    BOOST_TEST_EQ(failures, expected_failures);
+    delete[] invertible;
+
+    // Without flags, and in place:
+    std::vector<T> in_place(a);
+    BOOST_TEST_EQ(mod_inverse_batch(in_place.data(), m.data(), in_place.data(), a.size()), expected_failures);
+    BOOST_TEST(in_place == out);
+}
+
+template<class T>
+void test_mod_inverse_batch()
+{
+    // Every pair of small values, including moduli 0 and 1 and odd and even moduli:
+    std::vector<T> a, m;
+    for (int modulus = 0; modulus < 100; ++modulus)
+    {
+        for (int x = 0; x < 120; ++x)
+        {
+            a.push_back(static_cast<T>(x));
+            m.push_back(static_cast<T>(modulus));
+        }
+    }
+    check_batch(a, m);
+
+    // Large values, with a batch size that is not a multiple of the block size:
+    a.clear();
+    m.clear();
+    boost::uint32_t state = 12345;
+    const T top = (std::numeric_limits<T>::max)();
+    for (int i = 0; i < 1001; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        a.push_back(static_cast<T>(state % static_cast<boost::uint32_t>(top)));
+        state = state * 1664525u + 1013904223u;
+        m.push_back(static_cast<T>(top - static_cast<T>(state % 1000u)));
+    }
+    check_batch(a, m);
+}
+
+int main()
+{
+    test_mod_inverse_batch<boost::uint8_t>();
+    test_mod_inverse_batch<boost::int16_t>();
+    test_mod_inverse_batch<boost::uint16_t>();
+    test_mod_inverse_batch<boost::int32_t>();
+    test_mod_inverse_batch<boost::uint32_t>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,93 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/integer/mod_inverse_prime.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+// A table of inverses modulo a prime, built at compile time:
+struct inverse_table
+{
+   boost::uint32_t values[16];
+};
+
+constexpr inverse_table make_inverse_table(boost::uint32_t modulus)
+{
+   inverse_table t = {};
+   for (boost::uint32_t i = 1; i < 16; ++i)
+      boost::integer::mod_inverse(i, modulus, t.values[i]);
+   return t;
+}
+
+constexpr boost::int64_t extended_x(boost::int64_t m, boost::int64_t n)
+{
+   boost::integer::euclidean_result_t<boost::int64_t> r = {};
+   return boost::integer::extended_euclidean(m, n, r) ? r.x : -1;
+}
+
+constexpr bool invalid_is_reported()
+{
+   boost::integer::euclidean_x_result_t<unsigned> r = { 1, 1 };
+   int inv = 7;
+   return !boost::integer::extended_euclidean_x(0u, 5u, r) && r.gcd == 0
+      && !boost::integer::mod_inverse(3, 1, inv) && inv == 0
+      && !boost::integer::mod_inverse(4, 6, inv) && inv == 0;
+}
+
+void test_constexpr1()
+{
+   constexpr inverse_table t = make_inverse_table(65521);
+   static_assert(t.values[0] == 0, "Expected no inverse of zero.");
+   static_assert(t.values[2] == 32761, "Expected result not correct in constexpr mod_inverse.");
+   static_assert(t.values[7] * 7 % 65521 == 1, "Expected result not correct in constexpr mod_inverse.");
+}
+
+void test_constexpr2()
+{
+   constexpr boost::int64_t i = 347 * 463 * 727;
+   constexpr boost::int64_t j = 191 * 347 * 281;
+   constexpr boost::integer::euclidean_result_t<boost::int64_t> r = boost::integer::extended_euclidean(i, j);
+   static_assert(r.gcd == 347, "Expected result not correct in constexpr extended_euclidean.");
+   static_assert(i * r.x + j * r.y == 347, "Expected result not correct in constexpr extended_euclidean.");
+   static_assert(extended_x(i, j) == r.x, "Expected result not correct in constexpr extended_euclidean.");
+   static_assert(extended_x(0, j) == -1, "Expected invalid input to be reported.");
+   static_assert(boost::integer::extended_euclidean_x(i, j).x == r.x, "Expected result not correct in constexpr extended_euclidean_x.");
+   static_assert(boost::integer::mod_inverse(boost::uint64_t(3), boost::uint64_t(0xFFFFFFFFFFFFFFC5ull)) * 3 % 0xFFFFFFFFFFFFFFC5ull == 1,
+      "Expected result not correct in constexpr mod_inverse.");
+   static_assert(invalid_is_reported(), "Expected invalid input to be reported.");
+}
+
+void test_constexpr3()
+{
+   constexpr boost::uint64_t a = 0x9E3779B97F4A7C15ull;
+   static_assert(boost::integer::inverse_mod_pow2(a) * a == 1u, "Expected result not correct in constexpr inverse_mod_pow2.");
+   static_assert(boost::integer::inverse_mod_pow2(boost::uint32_t(7)) * 7u == 1u, "Expected result not correct in constexpr inverse_mod_pow2.");
+   static_assert(boost::integer::inverse_mod_pow2(boost::uint64_t(7), 3) == 7u, "Expected result not correct in constexpr inverse_mod_pow2.");
+   static_assert(boost::integer::inverse_mod_pow2(boost::uint16_t(10)) == 0u, "Expected no inverse of an even value.");
+   static_assert(boost::integer::mod_inverse_prime(3u, 4294967291u) == boost::integer::mod_inverse(3u, 4294967291u),
+      "Expected result not correct in constexpr mod_inverse_prime.");
+   static_assert(boost::integer::mod_inverse_prime(boost::int64_t(-2), boost::int64_t(998244353)) == 499122176,
+      "Expected result not correct in constexpr mod_inverse_prime.");
+}
+
+#endif
+
+#ifndef BOOST_NO_CXX11_NOEXCEPT
+
+void test_noexcept(int a, int b)
+{
+   boost::integer::euclidean_result_t<int> r = {};
+   boost::integer::euclidean_x_result_t<unsigned long> rx = {};
+   long inv = 0;
+   static_assert(noexcept(boost::integer::extended_euclidean(a, b, r)), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::extended_euclidean_x(static_cast<unsigned long>(a), static_cast<unsigned long>(b), rx)), "Expected a noexcept function.");
+   static_assert(noexcept(boost::integer::mod_inverse(static_cast<long>(a), static_cast<long>(b), inv)), "Expected a noexcept function.");
+   static_assert(!noexcept(boost::integer::extended_euclidean(a, b)), "Expected a throwing function.");
+   static_assert(!noexcept(boost::integer::mod_inverse(a, b)), "Expected a throwing function.");
+   static_assert(noexcept(boost::integer::inverse_mod_pow2(a)), "Expected a noexcept function.");
+}
+
+#endif
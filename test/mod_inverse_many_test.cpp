@@ -0,0 +1,152 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/integer/mod_inverse_many.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+#include <execution>
+#endif
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+using boost::integer::mod_inverse;
+using boost::integer::mod_inverse_many;
+
+template<class Z>
+void check_many(const std::vector<Z>& a, const Z& m)
+{
+    std::vector<Z> expected(a.size());
+    std::size_t expected_failures = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        expected_failures += !mod_inverse(a[i], m, expected[i]);
+    }
+
+    std::vector<Z> out(a.size(), Z(7));
+    BOOST_TEST_EQ(mod_inverse_many(a.begin(), a.end(), m, out.begin()), expected_failures);
+    BOOST_TEST(out == expected);
+
+    // Input iterators, and an output iterator that appends:
+    std::list<Z> in(a.begin(), a.end());
+    std::vector<Z> appended;
+    BOOST_TEST_EQ(mod_inverse_many(in.begin(), in.end(), m, std::back_inserter(appended)), expected_failures);
+    BOOST_TEST(appended == expected);
+
+#if !defined(BOOST_NO_CXX17_HDR_EXECUTION)
+    std::vector<Z> par(a.size(), Z(7));
+    BOOST_TEST_EQ(mod_inverse_many(std::execution::seq, a.begin(), a.end(), m, par.begin()), expected_failures);
+    BOOST_TEST(par == expected);
+    par.assign(a.size(), Z(7));
+    BOOST_TEST_EQ(mod_inverse_many(std::execution::par, a.begin(), a.end(), m, par.begin(), 37), expected_failures);
+    BOOST_TEST(par == expected);
+    par.assign(a.size(), Z(7));
+    BOOST_TEST_EQ(mod_inverse_many(std::execution::par_unseq, a.begin(), a.end(), m, par.begin(), 1), expected_failures);
+    BOOST_TEST(par == expected);
+#endif
+}
+
+template<class Z>
+void test_mod_inverse_many()
+{
+    std::vector<Z> a;
+    // Every residue, and some beyond the modulus, for a prime and two composite moduli:
+    Z moduli[] = { Z(2), Z(97), Z(100), Z(105) };
+    for (std::size_t j = 0; j < sizeof(moduli) / sizeof(moduli[0]); ++j)
+    {
+        a.clear();
+        for (int x = 0; x < 250; ++x)
+        {
+            a.push_back(Z(x));
+        }
+        check_many(a, moduli[j]);
+    }
+
+    // Large values, more than one chunk, and a few multiples of the modulus' factors:
+    const Z top = (std::numeric_limits<Z>::max)();
+    const Z m = Z(top - Z(top % Z(1000)) - Z(1));
+    boost::uint32_t state = 12345;
+    a.clear();
+    for (int i = 0; i < 5000; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        a.push_back(Z(top - Z(state % static_cast<boost::uint32_t>(top))));
+    }
+    Z factor = Z(2);
+    while (m % factor != Z(0))
+    {
+        ++factor;
+    }
+    a[17] = Z(0);
+    a[1234] = m;
+    a[4999] = Z(factor * Z(3));
+    check_many(a, m);
+
+    std::vector<Z> empty;
+    check_many(empty, Z(13));
+
+    Z out[1];
+    BOOST_TEST_THROWS(mod_inverse_many(a.begin(), a.end(), Z(1), out), std::domain_error);
+}
+
+template<class Z>
+void test_negative_values()
+{
+    std::vector<Z> a;
+    for (int x = -300; x < 300; ++x)
+    {
+        a.push_back(Z(x));
+    }
+    check_many(a, Z(101));
+    check_many(a, Z(120));
+}
+
+#ifndef DISABLE_MP_TESTS
+void test_multiprecision()
+{
+    using boost::multiprecision::cpp_int;
+    // 2^521 - 1 is prime, 2^522 - 2 is not:
+    cpp_int p = (cpp_int(1) << 521) - 1;
+    std::vector<cpp_int> a;
+    cpp_int x = 3;
+    for (int i = 0; i < 200; ++i)
+    {
+        x = (x * x + 1) % (p * 3);
+        a.push_back(x);
+    }
+    a.push_back(cpp_int(0));
+    a.push_back(p);
+    a.push_back(-a[5]);
+    check_many(a, p);
+    check_many(a, cpp_int(2 * p));
+}
+#endif
+
+int main()
+{
+    test_mod_inverse_many<int>();
+    test_mod_inverse_many<unsigned>();
+    test_mod_inverse_many<boost::int64_t>();
+    test_mod_inverse_many<boost::uint64_t>();
+    test_mod_inverse_many<boost::uint16_t>();
+    test_negative_values<int>();
+    test_negative_values<boost::int64_t>();
+#ifndef DISABLE_MP_TESTS
+    test_multiprecision();
+#endif
+
+    return boost::report_errors();
+}
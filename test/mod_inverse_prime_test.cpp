@@ -0,0 +1,119 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/integer/mod_inverse_prime.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/multiprecision/cpp_int.hpp>
+#endif
+
+using boost::integer::mod_inverse;
+using boost::integer::mod_inverse_prime;
+
+template<class Z>
+void check_prime(const Z& p, int count = 200)
+{
+    std::vector<Z> a;
+    for (int x = -count / 3; x < count - count / 3; ++x)
+    {
+        if (std::numeric_limits<Z>::is_signed || x >= 0)
+        {
+            a.push_back(Z(x));
+        }
+    }
+    Z x = Z(p / 3);
+    for (int i = 0; i < count; ++i)
+    {
+        x = Z(x / 2 + Z(p / 5) + Z(i));
+        a.push_back(Z(p - Z(i)));
+        a.push_back(x);
+    }
+    a.push_back(p);
+
+    std::vector<Z> expected(a.size());
+    std::size_t expected_failures = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        expected_failures += !mod_inverse(a[i], p, expected[i]);
+        BOOST_TEST(mod_inverse_prime(a[i], p) == expected[i]);
+    }
+    std::vector<Z> out(a.size(), Z(7));
+    BOOST_TEST_EQ(mod_inverse_prime(a.data(), out.data(), a.size(), p), expected_failures);
+    BOOST_TEST(out == expected);
+    // In place:
+    BOOST_TEST_EQ(mod_inverse_prime(a.data(), a.data(), a.size(), p), expected_failures);
+    BOOST_TEST(a == expected);
+}
+
+template<class Z>
+void test_mod_inverse_prime()
+{
+    const int small_primes[] = { 2, 3, 5, 7, 11, 13, 17, 31, 97, 101, 127 };
+    for (std::size_t i = 0; i < sizeof(small_primes) / sizeof(small_primes[0]); ++i)
+    {
+        check_prime(Z(small_primes[i]));
+    }
+    if (std::numeric_limits<Z>::digits >= 16)
+    {
+        check_prime(Z(32749));
+    }
+    if (std::numeric_limits<Z>::digits >= 31)
+    {
+        check_prime(Z(998244353));
+        check_prime(Z(2147483647));
+    }
+    if (std::numeric_limits<Z>::digits >= 32)
+    {
+        check_prime(Z(4294967291u));
+    }
+    if (std::numeric_limits<Z>::digits >= 63)
+    {
+        check_prime(Z(9223372036854775783ull));
+    }
+    if (std::numeric_limits<Z>::digits >= 64)
+    {
+        check_prime(Z(18446744073709551557ull));
+    }
+    BOOST_TEST_THROWS(mod_inverse_prime(Z(3), Z(1)), std::domain_error);
+    Z out = 0;
+    BOOST_TEST_THROWS(mod_inverse_prime(&out, &out, 1, Z(0)), std::domain_error);
+}
+
+#ifndef DISABLE_MP_TESTS
+void test_multiprecision()
+{
+    using boost::multiprecision::cpp_int;
+    check_prime((cpp_int(1) << 127) - 1);
+    check_prime((cpp_int(1) << 521) - 1, 20);
+    check_prime(boost::multiprecision::uint256_t("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F"), 5);
+}
+#endif
+
+int main()
+{
+    test_mod_inverse_prime<boost::uint8_t>();
+    test_mod_inverse_prime<boost::int16_t>();
+    test_mod_inverse_prime<int>();
+    test_mod_inverse_prime<unsigned>();
+    test_mod_inverse_prime<boost::int64_t>();
+    test_mod_inverse_prime<boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_mod_inverse_prime<boost::uint128_type>();
+#endif
+#ifndef DISABLE_MP_TESTS
+    test_multiprecision();
+#endif
+
+    return boost::report_errors();
+}
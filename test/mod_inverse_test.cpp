@@ -54,12 +54,183 @@ void test_mod_inverse()
     }
 }
 
+template<class Z>
+void check_unsigned_inverse(Z a, Z modulus)
+{
+    Z inv_a = mod_inverse(a, modulus);
+    if (gcd(a, modulus) > 1)
+    {
+        BOOST_TEST(inv_a == 0);
+    }
+    else
+    {
+        BOOST_TEST(inv_a > 0);
+        BOOST_TEST(inv_a < modulus);
+        boost::multiprecision::uint256_t product = boost::multiprecision::uint256_t(inv_a) * boost::multiprecision::uint256_t(a);
+        BOOST_TEST(product % boost::multiprecision::uint256_t(modulus) == 1);
+    }
+}
+
+// Moduli up to the full width of unsigned types, where the signed algorithm would need a wider type:
+template<class Z>
+void test_unsigned_mod_inverse()
+{
+    for (Z modulus = 2; modulus < 200; ++modulus)
+    {
+        for (Z a = 1; a < modulus; ++a)
+        {
+            check_unsigned_inverse(a, modulus);
+        }
+    }
+    const Z top = (std::numeric_limits<Z>::max)();
+    for (Z i = 0; i < 100; ++i)
+    {
+        check_unsigned_inverse(static_cast<Z>(i + 2), top);
+        check_unsigned_inverse(static_cast<Z>(top - i - 1), top);
+        check_unsigned_inverse(static_cast<Z>(top / 2 + i), static_cast<Z>(top - 2));
+        check_unsigned_inverse(static_cast<Z>(top - i), static_cast<Z>(top / 3 * 2 + 1));
+    }
+}
+
+// A 4096-bit modulus, for which mod_inverse uses Lehmer's algorithm:
+void test_large_mod_inverse()
+{
+    using boost::multiprecision::cpp_int;
+    cpp_int modulus = (cpp_int(1) << 4096) - 1093337;
+    cpp_int a = 1;
+    for (int i = 0; i < 100; ++i)
+    {
+        a = (a * 0x9E3779B97F4A7C15ull + i) % modulus;
+        cpp_int inv = mod_inverse(a, modulus);
+        if (gcd(a, modulus) == 1)
+        {
+            BOOST_TEST(inv > 0);
+            BOOST_TEST(inv < modulus);
+            BOOST_TEST_EQ(inv * a % modulus, 1);
+        }
+        else
+        {
+            BOOST_TEST_EQ(inv, 0);
+        }
+        cpp_int inv2 = 5;
+        BOOST_TEST_EQ(mod_inverse(a, modulus, inv2), inv != 0);
+        BOOST_TEST_EQ(inv2, inv);
+    }
+    cpp_int inv = 5;
+    BOOST_TEST(!mod_inverse(cpp_int(3), cpp_int(1), inv));
+    BOOST_TEST_EQ(inv, 0);
+    // Negative a is reduced into [0, modulus):
+    BOOST_TEST(mod_inverse(cpp_int(-2), cpp_int(7), inv));
+    BOOST_TEST_EQ(inv, 3);
+}
+
+// a*x == 1 modulo 2^N in the unsigned type of T's width:
+template<class T>
+void check_inverse_mod_pow2(T a)
+{
+    typedef typename boost::make_unsigned<T>::type U;
+    T x = boost::integer::inverse_mod_pow2<T>(a);
+    if ((a & 1) == 0)
+    {
+        BOOST_TEST(x == 0);
+        return;
+    }
+    boost::multiprecision::cpp_int product = boost::multiprecision::cpp_int(static_cast<U>(a)) * static_cast<U>(x);
+    BOOST_TEST((product & boost::multiprecision::cpp_int((std::numeric_limits<U>::max)())) == 1);
+    // And modulo 2^k, by truncation:
+    const unsigned digits = std::numeric_limits<T>::digits;
+    for (unsigned k = 1; k <= digits; k += 7)
+    {
+        T xk = boost::integer::inverse_mod_pow2(a, k);
+        BOOST_TEST(xk >= 0);
+        BOOST_TEST(boost::multiprecision::cpp_int(xk) == (boost::multiprecision::cpp_int(static_cast<U>(x)) & ((boost::multiprecision::cpp_int(1) << k) - 1)));
+    }
+}
+
+template<class T>
+void test_inverse_mod_pow2()
+{
+    for (int a = -100; a < 100; ++a)
+    {
+        if (std::numeric_limits<T>::is_signed || a >= 0)
+        {
+            check_inverse_mod_pow2(static_cast<T>(a));
+        }
+    }
+    const T top = (std::numeric_limits<T>::max)();
+    for (int i = 0; i < 100; ++i)
+    {
+        check_inverse_mod_pow2(static_cast<T>(top - i));
+        check_inverse_mod_pow2(static_cast<T>(top / 3 + i));
+    }
+    BOOST_TEST_THROWS(boost::integer::inverse_mod_pow2(T(3), 0u), std::domain_error);
+    BOOST_TEST_THROWS(boost::integer::inverse_mod_pow2(T(3), std::numeric_limits<T>::digits + 1u), std::domain_error);
+}
+
+// Multiprecision types: fixed width unsigned, and unbounded with any k.
+void test_multiprecision_inverse_mod_pow2()
+{
+    using boost::multiprecision::cpp_int;
+    using boost::multiprecision::uint256_t;
+    using boost::integer::inverse_mod_pow2;
+    uint256_t a = 1;
+    for (int i = 0; i < 100; ++i)
+    {
+        a = a * 0x9E3779B97F4A7C15ull + i;
+        uint256_t x = inverse_mod_pow2(a);
+        BOOST_TEST_EQ(x * a, (a & 1u) ? 1u : 0u);
+        BOOST_TEST_EQ(inverse_mod_pow2(a, 100), x & ((uint256_t(1) << 100) - 1u));
+        BOOST_TEST_EQ(inverse_mod_pow2(a, 256), x);
+        BOOST_TEST_EQ(inverse_mod_pow2(cpp_int(a), 256), cpp_int(x));
+    }
+    const unsigned widths[] = { 1, 2, 3, 5, 6, 11, 64, 65, 127, 1000, 4096 };
+    cpp_int b = 1;
+    for (int i = 0; i < 50; ++i)
+    {
+        b = (b * 0x9E3779B97F4A7C15ull + i) | 1;
+        for (unsigned j = 0; j < sizeof(widths) / sizeof(widths[0]); ++j)
+        {
+            cpp_int modulus = cpp_int(1) << widths[j];
+            cpp_int x = inverse_mod_pow2(b, widths[j]);
+            BOOST_TEST(x >= 0);
+            BOOST_TEST(x < modulus);
+            BOOST_TEST_EQ(x * b % modulus, 1);
+            // Negative values are reduced into [0, 2^k):
+            cpp_int y = inverse_mod_pow2(cpp_int(-b), widths[j]);
+            BOOST_TEST_EQ((y + x) % modulus, 0);
+        }
+    }
+    BOOST_TEST_EQ(inverse_mod_pow2(cpp_int(6), 10), 0);
+    BOOST_TEST_THROWS(inverse_mod_pow2(cpp_int(3), 0), std::domain_error);
+}
+
 int main()
 {
     test_mod_inverse<boost::int16_t>();
     test_mod_inverse<boost::int32_t>();
     test_mod_inverse<boost::int64_t>();
     test_mod_inverse<int128_t>();
+    test_large_mod_inverse();
+
+    test_unsigned_mod_inverse<boost::uint16_t>();
+    test_unsigned_mod_inverse<boost::uint32_t>();
+    test_unsigned_mod_inverse<boost::uint64_t>();
+    test_unsigned_mod_inverse<boost::multiprecision::uint128_t>();
+#ifdef BOOST_HAS_INT128
+    test_unsigned_mod_inverse<boost::uint128_type>();
+#endif
+
+    test_inverse_mod_pow2<boost::uint8_t>();
+    test_inverse_mod_pow2<boost::int16_t>();
+    test_inverse_mod_pow2<boost::int32_t>();
+    test_inverse_mod_pow2<boost::uint32_t>();
+    test_inverse_mod_pow2<boost::int64_t>();
+    test_inverse_mod_pow2<boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_inverse_mod_pow2<boost::int128_type>();
+    test_inverse_mod_pow2<boost::uint128_type>();
+#endif
+    test_multiprecision_inverse_mod_pow2();
 
     return boost::report_errors();
 }
@@ -0,0 +1,17 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/mod_pow.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+void test_constexpr1()
+{
+   static_assert(boost::integer::mod_pow(3u, 1000000005u, 1000000007u) == 333333336u, "Expected result not correct in constexpr mod_pow.");
+   static_assert(boost::integer::mod_pow(-3, 5, 1000) == 757, "Expected result not correct in constexpr mod_pow.");
+   static_assert(boost::integer::mod_pow(7ull, 0xFFFFFFFFFFFFFFFFull, 1ull << 40) == 471219269047ull, "Expected result not correct in constexpr mod_pow.");
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include "modular_test_values.hpp"
+#include <boost/integer/mod_pow.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::mod_pow;
+
+cpp_int reference(const cpp_int& base, const cpp_int& e, const cpp_int& m)
+{
+    cpp_int a = base % m;
+    if (a < 0)
+    {
+        a += m;
+    }
+    return m == 1 ? cpp_int(0) : cpp_int(boost::multiprecision::powm(a, e, m));
+}
+
+// The scalar form for a set of bases against powm, and the array form against the scalar one:
+template<class Z, class E>
+void check(const std::vector<Z>& bases, const E& e, const Z& m)
+{
+    const cpp_int cm = to_cpp_int(m);
+    const cpp_int ce = to_cpp_int(e);
+    std::vector<Z> expected;
+    for (std::size_t i = 0; i < bases.size(); ++i)
+    {
+        expected.push_back(mod_pow(bases[i], e, m));
+        BOOST_TEST(to_cpp_int(expected.back()) == reference(to_cpp_int(bases[i]), ce, cm));
+    }
+    std::vector<Z> out(bases.size());
+    mod_pow(bases.data(), out.data(), bases.size(), e, m);
+    BOOST_TEST(out == expected);
+    out = bases;
+    mod_pow(out.data(), out.data(), out.size(), e, m);
+    BOOST_TEST(out == expected);
+}
+
+template<class Z>
+void check_modulus(const Z& m, int count)
+{
+    const std::vector<Z> bases = modular_test_values(m, count);
+    const unsigned small[] = { 0, 1, 2, 3, 4, 5, 16, 17, 255, 1000003 };
+    for (std::size_t i = 0; i < sizeof(small) / sizeof(small[0]); ++i)
+    {
+        check(bases, small[i], m);
+    }
+    check(bases, m, m);
+    check(bases, (std::numeric_limits<boost::uint64_t>::max)(), m);
+    check(bases, static_cast<boost::int64_t>(0x123456789ABCDEFll), m);
+    // Exponents of every window width:
+    const int bits[] = { 24, 80, 240, 700, 1500 };
+    for (std::size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); ++i)
+    {
+        cpp_int e = 0;
+        for (int j = 0; j < bits[i]; j += 61)
+        {
+            e = (e << 61) | cpp_int(0x1234567890ABCDEFull + static_cast<unsigned>(j));
+        }
+        check(bases, e, m);
+    }
+}
+
+template<class Z>
+void test_mod_pow()
+{
+    // The reference results are slow for wide types:
+    const int count = !std::numeric_limits<Z>::is_bounded || std::numeric_limits<Z>::digits > 128 ? 2 : std::numeric_limits<Z>::digits > 64 ? 4 : 10;
+    const int small[] = { 1, 2, 3, 4, 5, 6, 9, 64, 100, 127 };
+    for (std::size_t i = 0; i < sizeof(small) / sizeof(small[0]); ++i)
+    {
+        check_modulus(Z(small[i]), count);
+    }
+    const Z top = std::numeric_limits<Z>::is_bounded ? (std::numeric_limits<Z>::max)() : Z(Z(1) << 300);
+    check_modulus(top, count);
+    check_modulus(Z(top - 1), count);
+    check_modulus(Z(Z(top / 3) | 1), count);
+    check_modulus(Z(Z(top / 2) + 1), count);
+    check_modulus(Z(Z(top / 2) + 2), count);
+
+    BOOST_TEST_THROWS(mod_pow(Z(2), 3u, Z(0)), std::domain_error);
+    BOOST_TEST_THROWS(mod_pow(Z(2), -1, Z(7)), std::domain_error);
+    Z v = 2;
+    BOOST_TEST_THROWS(mod_pow(&v, &v, 1, 3u, Z(0)), std::domain_error);
+    BOOST_TEST_THROWS(mod_pow(&v, &v, 1, cpp_int(-1), Z(7)), std::domain_error);
+    if (std::numeric_limits<Z>::is_signed)
+    {
+        BOOST_TEST_THROWS(mod_pow(Z(2), 3u, Z(-7)), std::domain_error);
+    }
+}
+
+// A width which is not a multiple of the limb size:
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<521, 521,
+    boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void> > uint521_t;
+
+int main()
+{
+    test_mod_pow<boost::uint8_t>();
+    test_mod_pow<boost::uint16_t>();
+    test_mod_pow<boost::uint32_t>();
+    test_mod_pow<boost::uint64_t>();
+    test_mod_pow<boost::int32_t>();
+    test_mod_pow<boost::int64_t>();
+#ifdef BOOST_HAS_INT128
+    test_mod_pow<boost::uint128_type>();
+    test_mod_pow<boost::int128_type>();
+#endif
+    test_mod_pow<boost::multiprecision::uint128_t>();
+    test_mod_pow<boost::multiprecision::uint256_t>();
+    test_mod_pow<uint521_t>();
+    test_mod_pow<cpp_int>();
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_INTEGER_TEST_MODULAR_TEST_VALUES_HPP_INCLUDED_
+#define BOOST_INTEGER_TEST_MODULAR_TEST_VALUES_HPP_INCLUDED_
+
+//
+// The reference conversion and operands shared by the tests of the modular arithmetic headers,
+// which check their results against cpp_int.  Include only where DISABLE_MP_TESTS is not defined.
+//
+
+#include <boost/cstdint.hpp>
+#include <boost/core/enable_if.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <limits>
+#include <vector>
+
+// Builtin values, the 128-bit ones included, in 32-bit pieces of their magnitude:
+template<class T>
+typename boost::enable_if_c<boost::is_integral<T>::value, boost::multiprecision::cpp_int>::type to_cpp_int(const T& a)
+{
+    typedef typename boost::make_unsigned<T>::type U;
+    const bool negative = a < T(0);
+    U v = negative ? U(U(0) - U(a)) : U(a);
+    boost::multiprecision::cpp_int result = 0;
+    for (int shift = 0; v != U(0); shift += 32)
+    {
+        result |= boost::multiprecision::cpp_int(static_cast<boost::uint32_t>(v & U(0xFFFFFFFFu))) << shift;
+        v >>= 16;
+        v >>= 16;
+    }
+    return negative ? boost::multiprecision::cpp_int(-result) : result;
+}
+
+template<class T>
+typename boost::enable_if_c<!boost::is_integral<T>::value, boost::multiprecision::cpp_int>::type to_cpp_int(const T& a)
+{
+    return boost::multiprecision::cpp_int(a);
+}
+
+//
+// count rounds of operands for the modulus m: values near 0, m and the maximum of Z, a
+// pseudo-random sequence, and values near the minimum of a signed Z.  An unbounded Z has the
+// negated pseudo-random value in place of the maximum.
+//
+template<class Z>
+std::vector<Z> modular_test_values(const Z& m, int count)
+{
+    std::vector<Z> values;
+    Z x = Z(m / 3);
+    for (int i = 0; i < count; ++i)
+    {
+        x = Z(x / 2 + Z(m / 5) + Z(i));
+        values.push_back(Z(i));
+        values.push_back(Z(m - Z(i % 3)));
+        if (std::numeric_limits<Z>::is_bounded)
+        {
+            values.push_back(Z((std::numeric_limits<Z>::max)() - Z(i)));
+        }
+        else
+        {
+            values.push_back(Z(Z(0) - x));
+        }
+        values.push_back(x);
+        if (std::numeric_limits<Z>::is_bounded && std::numeric_limits<Z>::is_signed)
+        {
+            values.push_back(Z((std::numeric_limits<Z>::min)() + Z(i)));
+        }
+    }
+    return values;
+}
+
+#endif // BOOST_INTEGER_TEST_MODULAR_TEST_VALUES_HPP_INCLUDED_
@@ -0,0 +1,30 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/montgomery.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+constexpr boost::uint64_t montgomery_product(boost::uint64_t a, boost::uint64_t b, boost::uint64_t p)
+{
+   boost::integer::montgomery_context<boost::uint64_t> ctx(p);
+   return ctx.from_montgomery(ctx.mul(ctx.to_montgomery(a), ctx.to_montgomery(b)));
+}
+
+void test_constexpr1()
+{
+   static_assert(montgomery_product(0xFFFFFFFFFFFFFFC4ull, 0xFFFFFFFFFFFFFFC4ull, 0xFFFFFFFFFFFFFFC5ull) == 1u,
+      "Expected result not correct in constexpr montgomery_context.");
+   constexpr boost::integer::montgomery_context<boost::uint32_t> ctx(4294967291u);
+   static_assert(ctx.from_montgomery(ctx.pow(ctx.to_montgomery(2u), 32u)) == 5u, "Expected result not correct in constexpr montgomery_context.");
+   static_assert(ctx.mul(ctx.inverse(ctx.to_montgomery(7u)), ctx.to_montgomery(7u)) == ctx.one(), "Expected result not correct in constexpr montgomery_context.");
+#ifdef BOOST_HAS_INT128
+   constexpr boost::integer::montgomery_context<boost::uint128_type> wide(~static_cast<boost::uint128_type>(0) - 158u);
+   static_assert(wide.from_montgomery(wide.sqr(wide.to_montgomery(~static_cast<boost::uint128_type>(0) - 159u))) == 1u,
+      "Expected result not correct in constexpr montgomery_context.");
+#endif
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include "modular_test_values.hpp"
+#include <boost/integer/montgomery.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::montgomery_context;
+
+template<class T>
+void check_modulus(const T& p, int count = 100)
+{
+    const montgomery_context<T> ctx(p);
+    const cpp_int m = to_cpp_int(p);
+    const cpp_int r = to_cpp_int(ctx.one());
+    BOOST_TEST(ctx.modulus() == p);
+    BOOST_TEST(r < m);
+    BOOST_TEST(ctx.from_montgomery(ctx.one()) == T(1));
+
+    const std::vector<T> values = modular_test_values(p, count);
+    T previous = T(2);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        const T x = values[i];
+        const cpp_int expected_x = to_cpp_int(x) % m;
+        const T mx = ctx.to_montgomery(x);
+        BOOST_TEST(to_cpp_int(mx) < m);
+        BOOST_TEST(to_cpp_int(ctx.from_montgomery(mx)) == expected_x);
+        BOOST_TEST(to_cpp_int(mx) == expected_x * r % m);
+
+        const T my = ctx.to_montgomery(previous);
+        const cpp_int expected_y = to_cpp_int(previous) % m;
+        BOOST_TEST(to_cpp_int(ctx.from_montgomery(ctx.mul(mx, my))) == expected_x * expected_y % m);
+        BOOST_TEST(ctx.sqr(mx) == ctx.mul(mx, mx));
+
+        const unsigned e = static_cast<unsigned>(i * 9);
+        BOOST_TEST(to_cpp_int(ctx.from_montgomery(ctx.pow(mx, e))) == boost::multiprecision::powm(expected_x, e, m));
+        BOOST_TEST(to_cpp_int(ctx.from_montgomery(ctx.pow(mx, p))) == boost::multiprecision::powm(expected_x, m, m));
+
+        const T inv = ctx.inverse(mx);
+        if (boost::multiprecision::gcd(expected_x, m) == 1)
+        {
+            BOOST_TEST(to_cpp_int(ctx.from_montgomery(inv)) * expected_x % m == 1);
+        }
+        else
+        {
+            BOOST_TEST(inv == T(0));
+        }
+        previous = x;
+    }
+    BOOST_TEST(ctx.pow(ctx.to_montgomery(T(5)), 0u) == ctx.one());
+}
+
+template<class T>
+void test_montgomery()
+{
+    // The reference results are slow for wide types:
+    const int count = std::numeric_limits<T>::digits > 128 ? 10 : 100;
+    check_modulus(T(3));
+    check_modulus(T(5));
+    check_modulus(T(127));
+    const T top = (std::numeric_limits<T>::max)();
+    check_modulus(top, count);
+    check_modulus(T(top - 2u), count);
+    check_modulus(T(T(top / 3u) | 1u), count);
+    check_modulus(T(T(top / 2u) + 2u), count);
+    check_modulus(T(T(top >> (std::numeric_limits<T>::digits / 2)) | 1u), count);
+
+    BOOST_TEST_THROWS(montgomery_context<T>(T(0)), std::domain_error);
+    BOOST_TEST_THROWS(montgomery_context<T>(T(1)), std::domain_error);
+    BOOST_TEST_THROWS(montgomery_context<T>(T(10)), std::domain_error);
+}
+
+// A width which is not a multiple of the limb size:
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<521, 521,
+    boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void> > uint521_t;
+
+int main()
+{
+    test_montgomery<boost::uint8_t>();
+    test_montgomery<boost::uint16_t>();
+    test_montgomery<boost::uint32_t>();
+    test_montgomery<boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_montgomery<boost::uint128_type>();
+#endif
+    test_montgomery<boost::multiprecision::uint128_t>();
+    test_montgomery<boost::multiprecision::uint256_t>();
+    test_montgomery<boost::multiprecision::uint512_t>();
+    test_montgomery<uint521_t>();
+    test_montgomery<boost::multiprecision::uint1024_t>();
+    check_modulus(boost::multiprecision::uint1024_t((boost::multiprecision::uint1024_t(1) << 1000) - 1u), 10);
+    check_modulus(uint521_t((uint521_t(1) << 521) - 1u), 10);
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
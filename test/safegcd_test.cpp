@@ -0,0 +1,148 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/integer/safegcd.hpp>
+#include <boost/integer/common_factor.hpp>
+#include <boost/integer/mod_inverse.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<4096, 4096, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void> > uint4096_t;
+
+template<class Traits, class T>
+void check_safegcd(const T& a, const T& b)
+{
+    // The reference results, in cpp_int so as to cover every type:
+    cpp_int ca(a);
+    cpp_int cb(b);
+    BOOST_TEST_EQ(cpp_int(boost::integer::safegcd_detail::gcd_ct<Traits>(a, b)), boost::integer::gcd(ca, cb));
+    if ((b & 1u) != 0u && b > 1u)
+    {
+        BOOST_TEST_EQ(cpp_int(boost::integer::safegcd_detail::mod_inverse_ct<Traits>(a, b)), boost::integer::mod_inverse(ca, cb));
+    }
+}
+
+// Interesting values for type T: small ones, those near powers of two and the maximum, consecutive
+// Fibonacci numbers (the worst case of Euclid's algorithm), and a pseudo-random sequence.
+template<class T>
+std::vector<T> safegcd_values()
+{
+    std::vector<T> v;
+    const int digits = std::numeric_limits<T>::digits;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        v.push_back(T(i));
+    }
+    for (int i = 1; i < digits; i += digits / 8 + 1)
+    {
+        T p = T(T(1) << i);
+        v.push_back(p);
+        v.push_back(T(p - 1u));
+        v.push_back(T(p + 1u));
+        v.push_back(T(p * 3u));
+    }
+    const T top = (std::numeric_limits<T>::max)();
+    v.push_back(top);
+    v.push_back(T(top - 1u));
+    v.push_back(T(top - 2u));
+    v.push_back(T(top / 3u));
+    T f0 = 1;
+    T f1 = 1;
+    while (f1 <= top - f0)
+    {
+        T next = T(f0 + f1);
+        f0 = f1;
+        f1 = next;
+    }
+    v.push_back(f0);
+    v.push_back(f1);
+    T x = 1;
+    for (int i = 0; i < 30; ++i)
+    {
+        x = T(x * T(0x9E3779B97F4A7C15ull) + T(i));
+        v.push_back(x);
+        v.push_back(T(x | 1u));
+        v.push_back(T(x << (digits / 2)));
+    }
+    return v;
+}
+
+template<class Traits, class T>
+void test_safegcd()
+{
+    std::vector<T> v = safegcd_values<T>();
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        for (std::size_t j = 0; j < v.size(); j += 3 + std::numeric_limits<T>::digits / 256)
+        {
+            check_safegcd<Traits>(v[i], v[j]);
+        }
+    }
+}
+
+template<class T>
+void test_public_interface()
+{
+    using boost::integer::gcd_ct;
+    using boost::integer::mod_inverse_ct;
+    BOOST_TEST(gcd_ct(T(0), T(0)) == 0u);
+    BOOST_TEST(gcd_ct(T(12), T(0)) == 12u);
+    BOOST_TEST(gcd_ct(T(0), T(18)) == 18u);
+    BOOST_TEST(gcd_ct(T(12), T(18)) == 6u);
+    BOOST_TEST(gcd_ct(T(64), T(96)) == 32u);
+    BOOST_TEST(mod_inverse_ct(T(2), T(5)) == 3u);
+    BOOST_TEST(mod_inverse_ct(T(7), T(5)) == 3u);
+    BOOST_TEST(mod_inverse_ct(T(0), T(5)) == 0u);
+    BOOST_TEST(mod_inverse_ct(T(6), T(9)) == 0u);
+    BOOST_TEST_THROWS(mod_inverse_ct(T(3), T(8)), std::domain_error);
+    BOOST_TEST_THROWS(mod_inverse_ct(T(3), T(1)), std::domain_error);
+}
+
+int main()
+{
+    using boost::integer::safegcd_detail::limb_traits;
+    using boost::integer::safegcd_detail::limb_traits_30;
+    using boost::multiprecision::uint256_t;
+    using boost::multiprecision::uint512_t;
+    using boost::multiprecision::uint1024_t;
+
+    test_safegcd<limb_traits, boost::uint8_t>();
+    test_safegcd<limb_traits, boost::uint16_t>();
+    test_safegcd<limb_traits, boost::uint32_t>();
+    test_safegcd<limb_traits, boost::uint64_t>();
+#ifdef BOOST_HAS_INT128
+    test_safegcd<limb_traits, boost::uint128_type>();
+#endif
+    test_safegcd<limb_traits, uint256_t>();
+    test_safegcd<limb_traits, uint512_t>();
+    test_safegcd<limb_traits, uint1024_t>();
+    test_safegcd<limb_traits, uint4096_t>();
+
+    test_safegcd<limb_traits_30, boost::uint16_t>();
+    test_safegcd<limb_traits_30, boost::uint32_t>();
+    test_safegcd<limb_traits_30, boost::uint64_t>();
+    test_safegcd<limb_traits_30, uint256_t>();
+    test_safegcd<limb_traits_30, uint1024_t>();
+
+    test_public_interface<unsigned>();
+    test_public_interface<uint256_t>();
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
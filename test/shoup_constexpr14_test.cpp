@@ -0,0 +1,17 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/shoup.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+void test_constexpr1()
+{
+   constexpr boost::integer::shoup_multiplier<boost::uint32_t> s(3u, 2013265921u);
+   static_assert(s.mul(0xFFFFFFFFu) == 805306359u, "Expected result not correct in constexpr shoup_multiplier.");
+   static_assert(s.mul_lazy(0u) == 0u, "Expected result not correct in constexpr shoup_multiplier.");
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/integer/shoup.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::shoup_multiplier;
+
+// Multipliers near 0 and p, and values near 0, p and 2^digits, and pseudo-random sequences:
+template<class T>
+void check_modulus(const T& p)
+{
+    const cpp_int cp = p;
+    const T top = (std::numeric_limits<T>::max)();
+    std::vector<T> a;
+    T x = T(p / 3u);
+    for (int i = 0; i < 40; ++i)
+    {
+        x = T(x / 2u + T(top / 5u) + T(i));
+        a.push_back(T(i));
+        a.push_back(T(p - T(i % 3)));
+        a.push_back(T(top - T(i)));
+        a.push_back(x);
+    }
+    std::vector<T> w;
+    std::vector<T> w_quotient;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const shoup_multiplier<T> s(a[a.size() - 1 - i], p);
+        BOOST_TEST(s.modulus() == p);
+        BOOST_TEST(cpp_int(s.multiplier()) == cpp_int(a[a.size() - 1 - i]) % cp);
+        BOOST_TEST(cpp_int(s.quotient()) == (cpp_int(s.multiplier()) << std::numeric_limits<T>::digits) / cp);
+        w.push_back(s.multiplier());
+        w_quotient.push_back(s.quotient());
+
+        std::vector<T> expected;
+        for (std::size_t j = 0; j < a.size(); ++j)
+        {
+            const cpp_int product = cpp_int(a[j]) * cpp_int(s.multiplier());
+            expected.push_back(static_cast<T>(product % cp));
+            BOOST_TEST(s.mul(a[j]) == expected.back());
+            const T lazy = s.mul_lazy(a[j]);
+            BOOST_TEST(cpp_int(lazy) < 2 * cp);
+            BOOST_TEST(cpp_int(lazy) % cp == product % cp);
+        }
+
+        // The array form, out of and in place:
+        if (i % 16 == 0)
+        {
+            std::vector<T> out(a.size());
+            s.mul(a.data(), out.data(), a.size());
+            BOOST_TEST(out == expected);
+            out = a;
+            s.mul(out.data(), out.data(), out.size());
+            BOOST_TEST(out == expected);
+        }
+    }
+
+    // A table of multipliers:
+    std::vector<T> q(w.size());
+    boost::integer::shoup_precompute(w.data(), q.data(), w.size(), p);
+    BOOST_TEST(q == w_quotient);
+    std::vector<T> out(a.size());
+    boost::integer::shoup_mul(a.data(), w.data(), q.data(), out.data(), a.size(), p);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        BOOST_TEST(cpp_int(out[i]) == cpp_int(a[i]) * cpp_int(w[i]) % cp);
+    }
+    boost::integer::shoup_mul(a.data(), w.data(), q.data(), a.data(), a.size(), p);
+    BOOST_TEST(a == out);
+}
+
+template<class T>
+void test_shoup()
+{
+    const int small[] = { 1, 2, 3, 4, 5, 7, 10, 64, 100, 127 };
+    for (std::size_t i = 0; i < sizeof(small) / sizeof(small[0]); ++i)
+    {
+        check_modulus(T(small[i]));
+    }
+    const T half = T(T(1u) << (std::numeric_limits<T>::digits - 1));
+    check_modulus(half);
+    check_modulus(T(half - 1u));
+    check_modulus(T(half / 3u));
+    check_modulus(T(T(half / 2u) + 1u));
+
+    BOOST_TEST_THROWS(shoup_multiplier<T>(T(1), T(0)), std::domain_error);
+    BOOST_TEST_THROWS(shoup_multiplier<T>(T(1), T(half + 1u)), std::domain_error);
+    BOOST_TEST_THROWS(shoup_multiplier<T>(T(1), (std::numeric_limits<T>::max)()), std::domain_error);
+    T v = 1;
+    BOOST_TEST_THROWS(boost::integer::shoup_precompute(&v, &v, 1, T(0)), std::domain_error);
+    BOOST_TEST_THROWS(boost::integer::shoup_mul(&v, &v, &v, &v, 1, T(half + 1u)), std::domain_error);
+}
+
+int main()
+{
+    test_shoup<boost::uint8_t>();
+    test_shoup<boost::uint16_t>();
+    test_shoup<boost::uint32_t>();
+#ifdef BOOST_HAS_INT128
+    test_shoup<boost::uint64_t>();
+#endif
+
+    return boost::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
@@ -0,0 +1,25 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/integer/static_modint.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+
+void test_constexpr1()
+{
+   typedef boost::integer::static_modint<998244353u> modint;
+   constexpr modint third = modint(3).pow(998244351u);
+   static_assert((third * 3).value() == 1u, "Expected result not correct in constexpr static_modint.");
+   static_assert((modint(-1) + 1).value() == 0u && (-modint(1)).value() == 998244352u, "Expected result not correct in constexpr static_modint.");
+   static_assert(modint(2).inverse().value() == 499122177u, "Expected result not correct in constexpr static_modint.");
+   static_assert((boost::integer::static_modint<1000000000u>(-3) * 7).value() == 999999979u, "Expected result not correct in constexpr static_modint.");
+#ifdef BOOST_HAS_INT128
+   typedef boost::integer::static_modint<0xFFFFFFFFFFFFFFC5ull> modint64;
+   static_assert((modint64(0xFFFFFFFFFFFFFFC4ull) * modint64(-1)).value() == 1u, "Expected result not correct in constexpr static_modint.");
+   static_assert((boost::integer::static_modint<1ull << 40>(-3) * 5).value() == (1ull << 40) - 15u, "Expected result not correct in constexpr static_modint.");
+#endif
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "multiprecision_config.hpp"
+
+#ifndef DISABLE_MP_TESTS
+#include <boost/integer/static_modint.hpp>
+#include <boost/integer/mod_pow.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using boost::multiprecision::cpp_int;
+using boost::integer::static_modint;
+
+template<class I>
+cpp_int residue(const I& a, const cpp_int& m)
+{
+    cpp_int r = cpp_int(a) % m;
+    return r < 0 ? cpp_int(r + m) : r;
+}
+
+// Values near 0, M and the limits of the word, and pseudo-random ones, through every operator:
+template<class Modint>
+void check_modint()
+{
+    typedef typename Modint::value_type value_type;
+    const value_type m = Modint::modulus();
+    const cpp_int cm = m;
+    const value_type top = (std::numeric_limits<value_type>::max)();
+    std::vector<value_type> a;
+    boost::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 24; ++i)
+    {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        a.push_back(value_type(i));
+        a.push_back(value_type(m - value_type(value_type(i % 3) % m)));
+        a.push_back(value_type(top - value_type(i)));
+        a.push_back(static_cast<value_type>(x >> (64 - std::numeric_limits<value_type>::digits)));
+    }
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const Modint u(a[i]);
+        BOOST_TEST(cpp_int(u.value()) == cpp_int(a[i]) % cm);
+        BOOST_TEST(cpp_int((-u).value()) == residue(-cpp_int(a[i]), cm));
+        for (std::size_t j = i % 5; j < a.size(); j += 5)
+        {
+            const Modint v(a[j]);
+            const cpp_int cu = cpp_int(a[i]) % cm;
+            const cpp_int cv = cpp_int(a[j]) % cm;
+            BOOST_TEST(cpp_int((u + v).value()) == (cu + cv) % cm);
+            BOOST_TEST(cpp_int((u - v).value()) == residue(cu - cv, cm));
+            BOOST_TEST(cpp_int((u * v).value()) == cu * cv % cm);
+            BOOST_TEST((u * v == v * u) && !(u * v != v * u));
+            BOOST_TEST((u == v) == (cu == cv));
+            Modint w = u;
+            w *= v;
+            w += u;
+            w -= v;
+            BOOST_TEST(cpp_int(w.value()) == residue(cu * cv + cu - cv, cm));
+        }
+        // Powers against mod_pow, and inverses:
+        const boost::uint64_t exponents[] = { 0u, 1u, 2u, 3u, 65537u, x, ~static_cast<boost::uint64_t>(0) };
+        for (std::size_t k = 0; k < sizeof(exponents) / sizeof(exponents[0]); ++k)
+        {
+            BOOST_TEST(u.pow(exponents[k]).value() == boost::integer::mod_pow(a[i], exponents[k], m));
+        }
+        const Modint inverse = u.inverse();
+        if (inverse != Modint())
+        {
+            BOOST_TEST((u * inverse).value() == 1u);
+        }
+        else
+        {
+            BOOST_TEST(m == 1u || boost::integer::gcd(cpp_int(a[i]) % cm, cm) != 1);
+        }
+    }
+
+    // Construction from every kind of integer, with mixed operands:
+    BOOST_TEST(cpp_int(Modint(-1).value()) == residue(-1, cm));
+    BOOST_TEST(cpp_int(Modint((std::numeric_limits<boost::int64_t>::min)()).value()) == residue((std::numeric_limits<boost::int64_t>::min)(), cm));
+    BOOST_TEST(cpp_int(Modint((std::numeric_limits<boost::int8_t>::min)()).value()) == residue(-128, cm));
+    BOOST_TEST(cpp_int(Modint(~static_cast<boost::uint64_t>(0)).value()) == residue(~static_cast<boost::uint64_t>(0), cm));
+    BOOST_TEST(cpp_int((Modint(5) * 3 - 20 + Modint(2)).value()) == residue(-3, cm));
+    BOOST_TEST(cpp_int((7 - Modint(9)).value()) == residue(-2, cm));
+#ifdef BOOST_HAS_INT128
+    const boost::uint128_type big = ~static_cast<boost::uint128_type>(0) - 12345u;
+    BOOST_TEST(cpp_int(Modint(big).value()) == residue(cpp_int(big), cm));
+    BOOST_TEST(cpp_int(Modint(-static_cast<boost::int128_type>(big >> 1)).value()) == residue(-cpp_int(big >> 1), cm));
+#endif
+    BOOST_TEST(Modint().value() == 0u);
+    BOOST_TEST_THROWS(Modint(2).pow(-1), std::domain_error);
+}
+
+int main()
+{
+    // Reduction by the constant modulus below 2^32:
+    check_modint< static_modint<1u> >();
+    check_modint< static_modint<2u> >();
+    check_modint< static_modint<3u> >();
+    check_modint< static_modint<998244353u> >();
+    check_modint< static_modint<1000000000u> >();
+    check_modint< static_modint<0x80000000u> >();
+    check_modint< static_modint<0xFFFFFFFEu> >();
+    check_modint< static_modint<4294967291u> >();
+    BOOST_TEST((static_modint<4294967291u>::value_type(0) == boost::uint32_t(0)));
+    // Montgomery's on request:
+    check_modint< static_modint<3u, true> >();
+    check_modint< static_modint<998244353u, true> >();
+    check_modint< static_modint<4294967291u, true> >();
+#ifdef BOOST_HAS_INT128
+    // Montgomery's by default above 2^32, and Barrett's for even moduli or on request:
+    check_modint< static_modint<4294967311ull> >();
+    check_modint< static_modint<0xFFFFFFFFFFFFFFC5ull> >();
+    check_modint< static_modint<4294967296ull> >();
+    check_modint< static_modint<0x8000000000000000ull> >();
+    check_modint< static_modint<0xFFFFFFFFFFFFFFFEull> >();
+    check_modint< static_modint<0xFFFFFFFFFFFFFFC5ull, false> >();
+#endif
+    return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,398 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Runs gcd_range, lcm_range or a pairwise gcd over a file of packed, fixed width, little endian
+// integers, which is memory mapped rather than read, using several threads, and reports the
+// throughput achieved.
+//
+// Usage: bulk_gcd [options] input-file
+//
+//    --width N        integer width in bits: 8, 16, 32 or 64 (default 64)
+//    --signed         the integers are two's complement rather than unsigned; the results are
+//                     their magnitudes, so the gcd of the minimum alone is 2^(width-1)
+//    --op OP          gcd: the gcd of the whole file (default)
+//                     lcm: the lcm of the whole file (wraps silently on overflow)
+//                     pairwise: the gcd of each consecutive pair of integers
+//    --output FILE    pairwise only: write the results, in the input format, to FILE
+//    --threads N      number of threads (default: all hardware threads)
+//
+
+#include <boost/integer/common_factor.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef BOOST_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+//
+// A read only mapping of an existing file, or a read/write mapping of a newly created file
+// of the given size.
+//
+class mapped_file
+{
+public:
+   explicit mapped_file(const std::string& path) : m_data(0), m_size(0) { open(path, false, 0); }
+   mapped_file(const std::string& path, std::size_t size) : m_data(0), m_size(0) { open(path, true, size); }
+   ~mapped_file() { close(); }
+
+   unsigned char* data() const { return m_data; }
+   std::size_t size() const { return m_size; }
+
+private:
+   mapped_file(const mapped_file&);
+   mapped_file& operator=(const mapped_file&);
+
+#ifdef BOOST_WINDOWS
+   void fail(const std::string& what, const std::string& path)
+   {
+      close();
+      throw std::runtime_error(what + " " + path + " failed with error " + std::to_string(GetLastError()));
+   }
+   void open(const std::string& path, bool create, std::size_t size)
+   {
+      m_file = CreateFileA(path.c_str(), create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, create ? 0 : FILE_SHARE_READ, 0,
+                           create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+      m_mapping = 0;
+      if (m_file == INVALID_HANDLE_VALUE)
+         fail("opening", path);
+      if (!create)
+      {
+         LARGE_INTEGER file_size;
+         if (!GetFileSizeEx(m_file, &file_size))
+            fail("sizing", path);
+         size = static_cast<std::size_t>(file_size.QuadPart);
+      }
+      if (size == 0)
+         return;
+      ULARGE_INTEGER map_size;
+      map_size.QuadPart = size;
+      m_mapping = CreateFileMappingA(m_file, 0, create ? PAGE_READWRITE : PAGE_READONLY, map_size.HighPart, map_size.LowPart, 0);
+      if (!m_mapping)
+         fail("mapping", path);
+      m_data = static_cast<unsigned char*>(MapViewOfFile(m_mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size));
+      if (!m_data)
+         fail("mapping", path);
+      m_size = size;
+   }
+   void close()
+   {
+      if (m_data)
+         UnmapViewOfFile(m_data);
+      if (m_mapping)
+         CloseHandle(m_mapping);
+      if (m_file != INVALID_HANDLE_VALUE)
+         CloseHandle(m_file);
+      m_data = 0;
+      m_mapping = 0;
+      m_file = INVALID_HANDLE_VALUE;
+   }
+   HANDLE m_file;
+   HANDLE m_mapping;
+#else
+   void fail(const std::string& what, const std::string& path)
+   {
+      std::string message = what + " " + path + ": " + std::strerror(errno);
+      close();
+      throw std::runtime_error(message);
+   }
+   void open(const std::string& path, bool create, std::size_t size)
+   {
+      m_fd = create ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666) : ::open(path.c_str(), O_RDONLY);
+      if (m_fd < 0)
+         fail("opening", path);
+      if (create)
+      {
+         if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+            fail("sizing", path);
+      }
+      else
+      {
+         struct stat st;
+         if (::fstat(m_fd, &st) != 0)
+            fail("sizing", path);
+         size = static_cast<std::size_t>(st.st_size);
+      }
+      if (size == 0)
+         return;
+      void* p = ::mmap(0, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_fd, 0);
+      if (p == MAP_FAILED)
+         fail("mapping", path);
+      m_data = static_cast<unsigned char*>(p);
+      m_size = size;
+      ::madvise(p, size, MADV_SEQUENTIAL);
+   }
+   void close()
+   {
+      if (m_data)
+         ::munmap(m_data, m_size);
+      if (m_fd >= 0)
+         ::close(m_fd);
+      m_data = 0;
+      m_fd = -1;
+   }
+   int m_fd;
+#endif
+
+   unsigned char* m_data;
+   std::size_t m_size;
+};
+
+//
+// Byte-wise little endian loads and stores: correct for any alignment and host byte order,
+// and compiled to plain moves on little endian hosts.
+//
+template <class T>
+T load(const unsigned char* p)
+{
+   typedef typename std::make_unsigned<T>::type U;
+   U v = 0;
+   for (std::size_t i = 0; i < sizeof(T); ++i)
+      v = static_cast<U>(v | static_cast<U>(static_cast<U>(p[i]) << (8 * i)));
+   return static_cast<T>(v);
+}
+
+template <class T>
+void store(unsigned char* p, T value)
+{
+   typedef typename std::make_unsigned<T>::type U;
+   U v = static_cast<U>(value);
+   for (std::size_t i = 0; i < sizeof(T); ++i)
+      p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+//
+// The gcd and lcm of signed integers are those of their magnitudes, which are computed in the
+// unsigned type of the same width: there the magnitude of the minimum fits, and no operand, zero
+// included, can make gcd divide by zero.
+//
+template <class T>
+typename std::make_unsigned<T>::type magnitude(T value)
+{
+   typedef typename std::make_unsigned<T>::type U;
+   return value < T(0) ? static_cast<U>(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+}
+
+// An iterator over the magnitudes of the packed integers, so that gcd_range and lcm_range work on the mapping directly.
+template <class T>
+class packed_iterator
+{
+public:
+   typedef typename std::make_unsigned<T>::type U;
+   typedef std::forward_iterator_tag iterator_category;
+   typedef U value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const U* pointer;
+   typedef U reference;
+
+   explicit packed_iterator(const unsigned char* p) : m_p(p) {}
+
+   U operator*() const { return magnitude(load<T>(m_p)); }
+   packed_iterator& operator++() { m_p += sizeof(T); return *this; }
+   packed_iterator operator++(int) { packed_iterator t(*this); ++*this; return t; }
+   bool operator==(const packed_iterator& o) const { return m_p == o.m_p; }
+   bool operator!=(const packed_iterator& o) const { return m_p != o.m_p; }
+
+private:
+   const unsigned char* m_p;
+};
+
+// Threads check for an early finish (a gcd of 1 or an lcm of 0) between blocks of this many integers:
+const std::size_t block_size = 1u << 16;
+
+// Splits [0, count) into one slice per thread t and runs f(t, first, last) on each.
+template <class F>
+void run_threads(std::size_t count, unsigned thread_count, F f)
+{
+   std::vector<std::thread> threads;
+   std::size_t per_thread = (count + thread_count - 1) / thread_count;
+   for (unsigned t = 0; t < thread_count; ++t)
+   {
+      std::size_t first = (std::min)(count, t * per_thread);
+      std::size_t last = (std::min)(count, first + per_thread);
+      threads.push_back(std::thread(f, t, first, last));
+   }
+   for (std::size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+}
+
+template <class T>
+std::string reduce(const unsigned char* data, std::size_t count, unsigned thread_count, bool is_lcm, std::size_t& processed)
+{
+   typedef typename std::make_unsigned<T>::type U;
+   const U absorbing = is_lcm ? U(0) : U(1);
+   std::vector<U> partial(thread_count, is_lcm ? U(1) : U(0));
+   std::atomic<bool> finished(false);
+   std::atomic<std::size_t> blocks_processed(0);
+
+   run_threads(count, thread_count, [&](unsigned t, std::size_t first, std::size_t last)
+   {
+      // Each slice starts from its first integer, and an empty slice from the identity:
+      U result = first < last ? magnitude(load<T>(data + first * sizeof(T))) : partial[t];
+      for (std::size_t b = first; b < last && !finished.load(std::memory_order_relaxed); b += block_size)
+      {
+         packed_iterator<T> begin(data + b * sizeof(T)), end(data + (std::min)(last, b + block_size) * sizeof(T));
+         U r = is_lcm ? boost::integer::lcm_range(begin, end).first : boost::integer::gcd_range(begin, end).first;
+         result = is_lcm ? boost::integer::lcm(result, r) : boost::integer::gcd(result, r);
+         if (result == absorbing)
+            finished.store(true, std::memory_order_relaxed);
+         blocks_processed.fetch_add((std::min)(last, b + block_size) - b, std::memory_order_relaxed);
+      }
+      partial[t] = result;
+   });
+   processed = blocks_processed;
+
+   if (finished)
+      return std::to_string(static_cast<unsigned long long>(absorbing));
+   U result = is_lcm ? U(1) : U(0);
+   for (unsigned t = 0; t < thread_count; ++t)
+      result = is_lcm ? boost::integer::lcm(result, partial[t]) : boost::integer::gcd(result, partial[t]);
+   return std::to_string(static_cast<unsigned long long>(result));
+}
+
+template <class T>
+std::string pairwise(const unsigned char* data, std::size_t count, unsigned thread_count, unsigned char* output)
+{
+   typedef typename std::make_unsigned<T>::type U;
+   std::vector<boost::uintmax_t> coprime(thread_count, 0);
+
+   run_threads(count / 2, thread_count, [&](unsigned t, std::size_t first, std::size_t last)
+   {
+      boost::uintmax_t n = 0;
+      for (std::size_t i = first; i < last; ++i)
+      {
+         // The magnitude of the minimum, which only the gcd of two minima or of a minimum and zero
+         // can be, is stored as the minimum itself, as gcd returns it:
+         U g = boost::integer::gcd(magnitude(load<T>(data + 2 * i * sizeof(T))), magnitude(load<T>(data + (2 * i + 1) * sizeof(T))));
+         if (g == U(1))
+            ++n;
+         if (output)
+            store<U>(output + i * sizeof(T), g);
+      }
+      coprime[t] = n;
+   });
+
+   boost::uintmax_t total = 0;
+   for (unsigned t = 0; t < thread_count; ++t)
+      total += coprime[t];
+   return std::to_string(count / 2) + " pairs, " + std::to_string(total) + " coprime";
+}
+
+template <class T>
+std::string run(const std::string& op, const mapped_file& input, const std::string& output_path, unsigned thread_count, std::size_t& processed)
+{
+   std::size_t count = input.size() / sizeof(T);
+   processed = count;
+   if (op == "pairwise")
+   {
+      if (output_path.empty())
+         return pairwise<T>(input.data(), count, thread_count, 0);
+      mapped_file output(output_path, count / 2 * sizeof(T));
+      return pairwise<T>(input.data(), count, thread_count, output.data());
+   }
+   if (count == 0)
+      throw std::runtime_error("the input file holds no integers");
+   return reduce<T>(input.data(), count, thread_count, op == "lcm", processed);
+}
+
+int usage()
+{
+   std::cerr << "Usage: bulk_gcd [--width 8|16|32|64] [--signed] [--op gcd|lcm|pairwise] [--output file] [--threads n] input-file" << std::endl;
+   return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+   unsigned width = 64;
+   bool is_signed = false;
+   std::string op = "gcd", input_path, output_path;
+   unsigned thread_count = std::thread::hardware_concurrency();
+
+   for (int i = 1; i < argc; ++i)
+   {
+      std::string arg = argv[i];
+      if (arg == "--signed")
+         is_signed = true;
+      else if (arg == "--width" && i + 1 < argc)
+         width = static_cast<unsigned>(std::atoi(argv[++i]));
+      else if (arg == "--op" && i + 1 < argc)
+         op = argv[++i];
+      else if (arg == "--output" && i + 1 < argc)
+         output_path = argv[++i];
+      else if (arg == "--threads" && i + 1 < argc)
+         thread_count = static_cast<unsigned>(std::atoi(argv[++i]));
+      else if (input_path.empty() && !arg.empty() && arg[0] != '-')
+         input_path = arg;
+      else
+         return usage();
+   }
+   if (input_path.empty() || (width != 8 && width != 16 && width != 32 && width != 64) || (op != "gcd" && op != "lcm" && op != "pairwise")
+       || (!output_path.empty() && op != "pairwise"))
+      return usage();
+   if (thread_count == 0)
+      thread_count = 1;
+
+   try
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      mapped_file input(input_path);
+      if (input.size() % (width / 8))
+         std::cerr << "bulk_gcd: ignoring " << input.size() % (width / 8) << " trailing bytes" << std::endl;
+
+      std::chrono::steady_clock::time_point mapped = std::chrono::steady_clock::now();
+      std::string result;
+      std::size_t processed = 0;
+      switch (width)
+      {
+      case 8: result = is_signed ? run<boost::int8_t>(op, input, output_path, thread_count, processed) : run<boost::uint8_t>(op, input, output_path, thread_count, processed); break;
+      case 16: result = is_signed ? run<boost::int16_t>(op, input, output_path, thread_count, processed) : run<boost::uint16_t>(op, input, output_path, thread_count, processed); break;
+      case 32: result = is_signed ? run<boost::int32_t>(op, input, output_path, thread_count, processed) : run<boost::uint32_t>(op, input, output_path, thread_count, processed); break;
+      default: result = is_signed ? run<boost::int64_t>(op, input, output_path, thread_count, processed) : run<boost::uint64_t>(op, input, output_path, thread_count, processed); break;
+      }
+      std::chrono::steady_clock::time_point done = std::chrono::steady_clock::now();
+
+      double map_seconds = std::chrono::duration<double>(mapped - start).count();
+      double seconds = std::chrono::duration<double>(done - mapped).count();
+      // The gcd and lcm stop early once the result reaches 1 or 0, so only count what was read:
+      double count = static_cast<double>(processed);
+      std::cout << op << ": " << result << "\n"
+                << processed << " of " << input.size() / (width / 8) << " integers of " << width << " bits processed by "
+                << thread_count << " threads in " << seconds << " s (+ " << map_seconds << " s to map)\n"
+                << "throughput: " << count / seconds / 1e6 << " M integers/s, "
+                << count * (width / 8) / seconds / 1e9 << " GB/s" << std::endl;
+   }
+   catch (const std::exception& e)
+   {
+      std::cerr << "bulk_gcd: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  https://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Benchmarks the three gcd algorithms for each builtin integer type on the machine it runs on,
+// and writes a header of boost::integer::gcd_detail::gcd_tuning specializations recording the
+// fastest method and the method_adaptive crossover points.  The result is used by defining
+// BOOST_INTEGER_GCD_TUNING_HEADER to the name of that header, which the CMake option
+// BOOST_INTEGER_GCD_AUTOTUNE arranges.
+//
+// Usage: gcd_autotune output-file [samples]
+//
+
+#ifdef BOOST_INTEGER_GCD_TUNING_HEADER
+#error "gcd_autotune must be built without a tuning header."
+#endif
+
+#include <boost/integer/common_factor_rt.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace boost::integer::gcd_detail;
+
+const char* method_names[] = { "method_euclid", "method_binary", "method_mixed", "method_adaptive" };
+
+struct bucket_result
+{
+   double time[3];  // indexed by method_type
+   method_type best() const
+   {
+      // Prefer mixed binary unless another method is clearly (5%) faster, so that noise does
+      // not flip the choice:
+      method_type result = method_mixed;
+      for (int m = method_euclid; m <= method_binary; ++m)
+         if (time[m] < 0.95 * time[result])
+            result = static_cast<method_type>(m);
+      return result;
+   }
+};
+
+std::mt19937_64 gen(42);
+volatile int observe;
+
+template <class T>
+T random_of_width(int bits)
+{
+   // A random value with exactly `bits` significant bits:
+   boost::ulong_long_type v = gen();
+   if (bits < 64)
+      v &= (boost::ulong_long_type(1) << bits) - 1;
+   v |= boost::ulong_long_type(1) << (bits - 1);
+   return static_cast<T>(v);
+}
+
+template <class T>
+double time_method(method_type m, const std::vector<T>& a, const std::vector<T>& b)
+{
+   double best = 1e300;
+   for (int rep = 0; rep < 5; ++rep)
+   {
+      T sink = 0;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < a.size(); ++i)
+      {
+         switch (m)
+         {
+         case method_euclid: sink ^= Euclid_gcd(a[i], b[i]); break;
+         case method_binary: sink ^= Stein_gcd(a[i], b[i]); break;
+         default: sink ^= mixed_binary_gcd(a[i], b[i]); break;
+         }
+      }
+      double t = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      observe = static_cast<int>(sink & 1);
+      if (t < best)
+         best = t;
+   }
+   return best / static_cast<double>(a.size());
+}
+
+template <class T>
+bucket_result measure(int bits_a, int bits_b, std::size_t samples)
+{
+   std::vector<T> a(samples), b(samples);
+   for (std::size_t i = 0; i < samples; ++i)
+   {
+      a[i] = random_of_width<T>(bits_a);
+      b[i] = random_of_width<T>(bits_b);
+   }
+   bucket_result r;
+   for (int m = method_euclid; m <= method_mixed; ++m)
+      r.time[m] = time_method<T>(static_cast<method_type>(m), a, b);
+   return r;
+}
+
+template <class T>
+void tune(std::ostream& os, const char* name, std::size_t samples)
+{
+   const int digits = std::numeric_limits<T>::digits;
+   const int step = digits >= 8 ? digits / 8 : 1;
+   const int never = digits + 1;
+
+   // Operands of equal width, and operands whose widths differ by a growing amount:
+   std::vector<int> widths, differences;
+   std::vector<bucket_result> equal, different;
+   for (int w = step; w <= digits; w += step)
+   {
+      widths.push_back(w);
+      equal.push_back(measure<T>(w, w, samples));
+   }
+   for (int d = step; d < digits; d += step)
+   {
+      differences.push_back(d);
+      different.push_back(measure<T>(digits, digits - d, samples));
+   }
+
+   int binary_max_bits = 0;
+   for (std::size_t i = 0; i < widths.size() && equal[i].best() == method_binary; ++i)
+      binary_max_bits = widths[i];
+   int euclid_min_bits = never;
+   for (std::size_t i = widths.size(); i > 0 && equal[i - 1].best() == method_euclid; --i)
+      euclid_min_bits = widths[i - 1];
+   int euclid_min_difference = never;
+   for (std::size_t i = differences.size(); i > 0 && different[i - 1].best() == method_euclid; --i)
+      euclid_min_difference = differences[i - 1];
+
+   //
+   // Total time over all the buckets for each fixed method, and for method_adaptive with the
+   // crossover points above (ignoring the cost of measuring the operands):
+   //
+   double total[4] = { 0, 0, 0, 0 };
+   for (std::size_t i = 0; i < equal.size(); ++i)
+   {
+      for (int m = 0; m < 3; ++m)
+         total[m] += equal[i].time[m];
+      total[method_adaptive] += equal[i].time[widths[i] >= euclid_min_bits ? method_euclid : widths[i] <= binary_max_bits ? method_binary : method_mixed];
+   }
+   for (std::size_t i = 0; i < different.size(); ++i)
+   {
+      for (int m = 0; m < 3; ++m)
+         total[m] += different[i].time[m];
+      total[method_adaptive] += different[i].time[(digits >= euclid_min_bits) || (differences[i] >= euclid_min_difference) ? method_euclid : method_mixed];
+   }
+
+   // Only select run time dispatch when it pays for itself by a clear margin:
+   int method = method_mixed;
+   if (total[method_binary] < 0.95 * total[method])
+      method = method_binary;
+   if (total[method_euclid] < 0.95 * total[method])
+      method = method_euclid;
+   if (total[method_adaptive] < 0.9 * total[method])
+      method = method_adaptive;
+
+   const double buckets = static_cast<double>(equal.size() + different.size());
+   os << "template <>\nstruct gcd_tuning<" << name << ">\n{\n"
+      << "   // average ns per call: euclid " << total[method_euclid] / buckets << ", binary " << total[method_binary] / buckets
+      << ", mixed " << total[method_mixed] / buckets << ", adaptive " << total[method_adaptive] / buckets << "\n"
+      << "   static const bool is_tuned = true;\n"
+      << "   static const method_type method = " << method_names[method] << ";\n"
+      << "   static const int adaptive_binary_max_bits = " << binary_max_bits << ";\n"
+      << "   static const int adaptive_euclid_min_bits = " << euclid_min_bits << ";\n"
+      << "   static const int adaptive_euclid_min_bit_difference = " << euclid_min_difference << ";\n"
+      << "};\n\n";
+   std::cout << name << ": " << method_names[method] << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      std::cerr << "Usage: gcd_autotune output-file [samples]" << std::endl;
+      return EXIT_FAILURE;
+   }
+   std::size_t samples = argc > 2 ? static_cast<std::size_t>(std::atol(argv[2])) : 2000u;
+
+   std::ofstream os(argv[1]);
+   if (!os)
+   {
+      std::cerr << "gcd_autotune: can't open " << argv[1] << std::endl;
+      return EXIT_FAILURE;
+   }
+   os << "// Generated by gcd_autotune, do not edit.\n"
+      << "// Included by <boost/integer/detail/gcd_tuning.hpp> via BOOST_INTEGER_GCD_TUNING_HEADER.\n\n"
+      << "#ifndef BOOST_INTEGER_GCD_TUNED_HPP\n#define BOOST_INTEGER_GCD_TUNED_HPP\n\n"
+      << "namespace boost {\nnamespace integer {\nnamespace gcd_detail {\n\n";
+
+   tune<signed char>(os, "signed char", samples);
+   tune<unsigned char>(os, "unsigned char", samples);
+   tune<short>(os, "short", samples);
+   tune<unsigned short>(os, "unsigned short", samples);
+   tune<int>(os, "int", samples);
+   tune<unsigned>(os, "unsigned int", samples);
+   tune<long>(os, "long", samples);
+   tune<unsigned long>(os, "unsigned long", samples);
+#ifdef BOOST_HAS_LONG_LONG
+   tune<boost::long_long_type>(os, "boost::long_long_type", samples);
+   tune<boost::ulong_long_type>(os, "boost::ulong_long_type", samples);
+#endif
+
+   os << "} // namespace gcd_detail\n} // namespace integer\n} // namespace boost\n\n"
+      << "#endif // BOOST_INTEGER_GCD_TUNED_HPP\n";
+   return os ? EXIT_SUCCESS : EXIT_FAILURE;
+}